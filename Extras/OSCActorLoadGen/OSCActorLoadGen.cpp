@@ -0,0 +1,618 @@
+// Headless load generator for the OSCActor plugin.
+//
+// Emits the same protocol as tox/OSCActor.tox (/sys/frame_number, /obj/<name>/TRS,
+// /obj/<name>/ss/<par>, /obj/<name>/ms/<chan>, /cam/<name>/...) at a fixed rate,
+// either over UDP or through the shared-memory transport, and counts the
+// /sys/frame_ack replies the plugin sends back when bSendFrameAck is enabled.
+// Every frame ends with /sys/frame_end <frame> <message count>, so a frame is
+// only acknowledged once all of its bundles arrived.
+//
+// Usage: OSCActorLoadGen [options], see --help.
+
+#include "OSCSharedMemoryWriter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef SOCKET socket_t;
+static const socket_t kInvalidSocket = INVALID_SOCKET;
+static void closeSocket(socket_t s) { closesocket(s); }
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+typedef int socket_t;
+static const socket_t kInvalidSocket = -1;
+static void closeSocket(socket_t s) { close(s); }
+#endif
+
+using Clock = std::chrono::steady_clock;
+using namespace oscactor;
+
+struct Options
+{
+	std::string host = "127.0.0.1";
+	int port = 7000;
+	int ackPort = 7001;
+	std::string shmName;
+
+	int objects = 1;
+	std::string objectPrefix = "obj";
+	int channels = 3;
+	int samples = 1000;
+	int scalars = 0;
+	int cameras = 0;
+	std::string mode = "ms"; // ms | msp
+	int patchSamples = 10;
+
+	double fps = 60;
+	double duration = 10;
+	int burst = 1;
+
+	size_t maxPacket = 60000;
+	uint32_t slotSize = 4 * 1024 * 1024;
+	double ackTimeout = 1.0;
+	bool quiet = false;
+};
+
+static void printUsage()
+{
+	std::printf(
+		"OSCActorLoadGen - headless OSC sender for soak / capacity testing\n"
+		"\n"
+		"  --host ADDR        receiver address (default 127.0.0.1)\n"
+		"  --port N           receiver port (default 7000)\n"
+		"  --shm NAME         publish through the shared-memory ring NAME instead of UDP\n"
+		"  --ack-port N       local port for /sys/frame_ack replies, 0 disables (default 7001)\n"
+		"  --objects N        number of /obj/<prefix><i> objects (default 1)\n"
+		"  --prefix NAME      object name prefix (default obj)\n"
+		"  --channels N       multi-sample channels per object: tx ty tz, then c0 c1 ... (default 3)\n"
+		"  --samples N        samples per channel (default 1000)\n"
+		"  --scalars N        ss parameters per object, p0 p1 ... (default 0)\n"
+		"  --cameras N        number of /cam/cam<i> cameras (default 0)\n"
+		"  --mode ms|msp      full channels, or sparse index/value patches (default ms)\n"
+		"  --patch N          samples patched per channel and frame in msp mode (default 10)\n"
+		"  --fps F            frames per second (default 60)\n"
+		"  --duration S       seconds to run, 0 runs until killed (default 10)\n"
+		"  --burst N          send N frames back to back, then idle N frame periods (default 1)\n"
+		"  --max-packet N     split frames into bundles of at most N bytes over UDP (default 60000)\n"
+		"  --slot-size N      shared-memory slot size in bytes, frames are split to fit (default 4194304)\n"
+		"  --quiet            only print the final report\n");
+}
+
+static bool parseOptions(int argc, char** argv, Options& o)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		auto next = [&]() -> const char*
+		{
+			if (i + 1 >= argc)
+			{
+				std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+				std::exit(1);
+			}
+			return argv[++i];
+		};
+
+		if (arg == "--help" || arg == "-h") { printUsage(); std::exit(0); }
+		else if (arg == "--host") o.host = next();
+		else if (arg == "--port") o.port = std::atoi(next());
+		else if (arg == "--shm") o.shmName = next();
+		else if (arg == "--ack-port") o.ackPort = std::atoi(next());
+		else if (arg == "--objects") o.objects = std::atoi(next());
+		else if (arg == "--prefix") o.objectPrefix = next();
+		else if (arg == "--channels") o.channels = std::atoi(next());
+		else if (arg == "--samples") o.samples = std::atoi(next());
+		else if (arg == "--scalars") o.scalars = std::atoi(next());
+		else if (arg == "--cameras") o.cameras = std::atoi(next());
+		else if (arg == "--mode") o.mode = next();
+		else if (arg == "--patch") o.patchSamples = std::atoi(next());
+		else if (arg == "--fps") o.fps = std::atof(next());
+		else if (arg == "--duration") o.duration = std::atof(next());
+		else if (arg == "--burst") o.burst = std::atoi(next());
+		else if (arg == "--max-packet") o.maxPacket = size_t(std::atoll(next()));
+		else if (arg == "--slot-size") o.slotSize = uint32_t(std::atoll(next()));
+		else if (arg == "--quiet") o.quiet = true;
+		else
+		{
+			std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+			return false;
+		}
+	}
+
+	if (o.fps <= 0 || o.objects < 0 || o.channels < 0 || o.samples < 0 || o.burst < 1)
+	{
+		std::fprintf(stderr, "invalid option value\n");
+		return false;
+	}
+
+	// Largest UDP payload over IPv4
+	static const size_t kMaxDatagram = 65507;
+	if (o.shmName.empty() && (o.maxPacket < 64 || o.maxPacket > kMaxDatagram))
+	{
+		std::fprintf(stderr, "--max-packet must be between 64 and %zu\n", kMaxDatagram);
+		return false;
+	}
+
+	if (!o.shmName.empty() && o.slotSize < 64)
+	{
+		std::fprintf(stderr, "--slot-size must be at least 64\n");
+		return false;
+	}
+
+	if (o.mode != "ms" && o.mode != "msp")
+	{
+		std::fprintf(stderr, "--mode must be ms or msp\n");
+		return false;
+	}
+
+	return true;
+}
+
+// ===================================================================================
+
+// Splits one frame into bundles that fit the transport's packet size.
+class FrameEncoder
+{
+public:
+
+	explicit FrameEncoder(size_t maxPacket) : MaxPacket(maxPacket) {}
+
+	// Every bundle of the frame carries timeTag, 1 meaning "immediately"
+	void begin(uint64_t timeTag = 1)
+	{
+		Packets.clear();
+		MessageCount = 0;
+		TimeTag = timeTag;
+		startBundle();
+	}
+
+	// Each message is encoded on its own first so it can be moved to a new
+	// bundle when the current one would overflow. Returns false, and drops the
+	// message, if it doesn't fit into a packet even on its own.
+	template <typename F>
+	bool add(F&& encode)
+	{
+		Scratch.clear();
+		encode(Scratch);
+
+		const std::vector<uint8_t>& element = Scratch.data();
+		if (kBundleHeaderSize + 4 + element.size() > MaxPacket)
+		{
+			LargestRejected = std::max(LargestRejected, element.size());
+			return false;
+		}
+
+		if (!empty() && Packet.size() + 4 + element.size() > MaxPacket)
+			flush();
+
+		const uint32_t size = uint32_t(element.size());
+		Packet.push_back(uint8_t(size >> 24));
+		Packet.push_back(uint8_t(size >> 16));
+		Packet.push_back(uint8_t(size >> 8));
+		Packet.push_back(uint8_t(size));
+		Packet.insert(Packet.end(), element.begin(), element.end());
+
+		MessageCount++;
+		return true;
+	}
+
+	// Messages added since begin()
+	int32_t messageCount() const { return MessageCount; }
+
+	// Size of the largest message that didn't fit, 0 if none
+	size_t largestRejected() const { return LargestRejected; }
+
+	const std::vector<std::vector<uint8_t>>& end()
+	{
+		if (!empty())
+			flush();
+		return Packets;
+	}
+
+private:
+
+	static constexpr size_t kBundleHeaderSize = 16; // "#bundle\0" + time tag
+
+	bool empty() const { return Packet.size() <= kBundleHeaderSize; }
+
+	void startBundle()
+	{
+		// Built separately: Scratch may still hold the message that triggered the flush
+		OSCPacketBuilder header;
+		header.beginBundle(TimeTag).endBundle();
+		Packet = header.data();
+	}
+
+	void flush()
+	{
+		Packets.push_back(std::move(Packet));
+		startBundle();
+	}
+
+	size_t MaxPacket;
+	uint64_t TimeTag = 1;
+	int32_t MessageCount = 0;
+	size_t LargestRejected = 0;
+	OSCPacketBuilder Scratch;
+	std::vector<uint8_t> Packet;
+	std::vector<std::vector<uint8_t>> Packets;
+};
+
+// ===================================================================================
+
+// Current wall clock as an OSC (NTP 32.32) time tag
+static uint64_t ntpTimeTag()
+{
+	static const uint64_t kUnixToNtpSeconds = 2208988800ull;
+
+	const auto sinceUnix = std::chrono::system_clock::now().time_since_epoch();
+	const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(sinceUnix);
+	const auto fraction = std::chrono::duration_cast<std::chrono::nanoseconds>(sinceUnix - seconds);
+
+	return ((uint64_t(seconds.count()) + kUnixToNtpSeconds) << 32) | ((uint64_t(fraction.count()) << 32) / 1000000000ull);
+}
+
+static socket_t openUdpSocket(int bindPort)
+{
+	socket_t s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (s == kInvalidSocket)
+		return s;
+
+	if (bindPort > 0)
+	{
+		sockaddr_in addr = {};
+		addr.sin_family = AF_INET;
+		addr.sin_addr.s_addr = htonl(INADDR_ANY);
+		addr.sin_port = htons(uint16_t(bindPort));
+		if (bind(s, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+		{
+			closeSocket(s);
+			return kInvalidSocket;
+		}
+
+#if defined(_WIN32)
+		u_long nonBlocking = 1;
+		ioctlsocket(s, FIONBIO, &nonBlocking);
+#else
+		fcntl(s, F_SETFL, fcntl(s, F_GETFL, 0) | O_NONBLOCK);
+#endif
+	}
+
+	return s;
+}
+
+static uint32_t readU32(const uint8_t* p)
+{
+	return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+// Parses a bare "/sys/frame_ack ,i <n>" message.
+static bool parseFrameAck(const uint8_t* data, size_t size, int32_t& frame)
+{
+	static const char kAddress[] = "/sys/frame_ack";
+	const size_t addressSize = (sizeof(kAddress) + 3) & ~size_t(3);
+
+	if (size < addressSize + 8 || std::memcmp(data, kAddress, sizeof(kAddress)) != 0)
+		return false;
+
+	if (data[addressSize] != ',' || data[addressSize + 1] != 'i')
+		return false;
+
+	frame = int32_t(readU32(data + addressSize + 4));
+	return true;
+}
+
+// ===================================================================================
+
+struct Stats
+{
+	uint64_t framesSent = 0;
+	uint64_t packetsSent = 0;
+	uint64_t bytesSent = 0;
+	uint64_t sendErrors = 0;
+	uint64_t acks = 0;
+	std::vector<double> latencies;
+};
+
+static double percentile(std::vector<double> v, double p)
+{
+	if (v.empty())
+		return 0;
+	std::sort(v.begin(), v.end());
+	return v[std::min(v.size() - 1, size_t(p * double(v.size() - 1) + 0.5))];
+}
+
+int main(int argc, char** argv)
+{
+	Options o;
+	if (!parseOptions(argc, argv, o))
+		return 1;
+
+#if defined(_WIN32)
+	WSADATA wsaData;
+	WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+
+	const bool useShm = !o.shmName.empty();
+	if (useShm)
+		o.maxPacket = o.slotSize;
+
+	SharedMemoryWriter shm;
+	socket_t sendSocket = kInvalidSocket;
+	sockaddr_in target = {};
+
+	if (useShm)
+	{
+		if (!shm.open(o.shmName, 8, o.slotSize))
+		{
+			std::fprintf(stderr, "failed to open shared memory '%s'\n", o.shmName.c_str());
+			return 1;
+		}
+	}
+	else
+	{
+		sendSocket = openUdpSocket(0);
+		target.sin_family = AF_INET;
+		target.sin_port = htons(uint16_t(o.port));
+		if (sendSocket == kInvalidSocket || inet_pton(AF_INET, o.host.c_str(), &target.sin_addr) != 1)
+		{
+			std::fprintf(stderr, "failed to set up UDP target %s:%d\n", o.host.c_str(), o.port);
+			return 1;
+		}
+	}
+
+	socket_t ackSocket = kInvalidSocket;
+	if (o.ackPort > 0)
+	{
+		ackSocket = openUdpSocket(o.ackPort);
+		if (ackSocket == kInvalidSocket)
+			std::fprintf(stderr, "warning: can't bind ack port %d, acks won't be counted\n", o.ackPort);
+	}
+
+	std::vector<std::string> channelNames;
+	static const char* kTranslate[] = { "tx", "ty", "tz" };
+	for (int c = 0; c < o.channels; c++)
+		channelNames.push_back(c < 3 ? kTranslate[c] : "c" + std::to_string(c - 3));
+
+	std::vector<std::string> objectNames;
+	for (int i = 0; i < o.objects; i++)
+		objectNames.push_back(o.objectPrefix + std::to_string(i));
+
+	FrameEncoder encoder(o.maxPacket);
+	std::vector<float> values(size_t(std::max(o.samples, 9)));
+	std::map<int32_t, Clock::time_point> pendingFrames;
+	Stats stats;
+	uint32_t rng = 1;
+
+	auto pollAcks = [&]()
+	{
+		if (ackSocket == kInvalidSocket)
+			return;
+
+		uint8_t buffer[1500];
+		for (;;)
+		{
+			const auto n = recv(ackSocket, reinterpret_cast<char*>(buffer), sizeof(buffer), 0);
+			if (n <= 0)
+				break;
+
+			int32_t frame;
+			if (!parseFrameAck(buffer, size_t(n), frame))
+				continue;
+
+			stats.acks++;
+
+			auto it = pendingFrames.find(frame);
+			if (it != pendingFrames.end())
+			{
+				stats.latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - it->second).count());
+				pendingFrames.erase(pendingFrames.begin(), std::next(it));
+			}
+		}
+	};
+
+	auto sendFrame = [&](int32_t frame, double t)
+	{
+		encoder.begin(ntpTimeTag());
+
+		encoder.add([&](OSCPacketBuilder& b) { b.message("/sys/frame_number", frame); });
+
+		for (int i = 0; i < o.cameras; i++)
+		{
+			const std::string base = "/cam/cam" + std::to_string(i);
+			const float trs[9] = { float(std::sin(t + i)), 1, 5, 0, float(t * 10), 0, 1, 1, 1 };
+			encoder.add([&](OSCPacketBuilder& b) { b.message(base + "/active", true); });
+			encoder.add([&](OSCPacketBuilder& b) { b.message(base + "/TRS", trs, 9); });
+			encoder.add([&](OSCPacketBuilder& b) { const float f = 35; b.message(base + "/focal", &f, 1); });
+		}
+
+		for (int i = 0; i < o.objects; i++)
+		{
+			const std::string base = "/obj/" + objectNames[size_t(i)];
+			const float phase = float(t) + float(i) * 0.1f;
+			const float trs[9] = { std::sin(phase), 0, std::cos(phase), 0, phase * 30, 0, 1, 1, 1 };
+
+			encoder.add([&](OSCPacketBuilder& b) { b.message(base + "/active", true); });
+			encoder.add([&](OSCPacketBuilder& b) { b.message(base + "/TRS", trs, 9); });
+
+			for (int p = 0; p < o.scalars; p++)
+			{
+				const float v = std::sin(phase * float(p + 1));
+				encoder.add([&](OSCPacketBuilder& b) { b.message(base + "/ss/p" + std::to_string(p), &v, 1); });
+			}
+
+			for (int c = 0; c < o.channels; c++)
+			{
+				const std::string address = base + "/" + o.mode + "/" + channelNames[size_t(c)];
+
+				if (o.mode == "ms")
+				{
+					for (int s = 0; s < o.samples; s++)
+						values[size_t(s)] = std::sin(phase + float(s) * 0.01f + float(c));
+
+					encoder.add([&](OSCPacketBuilder& b) { b.message(address, values.data(), size_t(o.samples)); });
+				}
+				else
+				{
+					const int patch = std::min(o.patchSamples, o.samples);
+					encoder.add([&](OSCPacketBuilder& b)
+					{
+						std::string tags = "i";
+						for (int k = 0; k < patch; k++)
+							tags += "if";
+
+						b.beginMessage(address, tags).addInt32(o.samples);
+						for (int k = 0; k < patch; k++)
+						{
+							rng = rng * 1664525u + 1013904223u;
+							const int32_t index = int32_t(rng % uint32_t(std::max(o.samples, 1)));
+							b.addInt32(index).addFloat(std::sin(phase + float(index) * 0.01f));
+						}
+						b.endMessage();
+					});
+				}
+			}
+		}
+
+		// Counts the messages of the whole frame, including both markers
+		encoder.add([&](OSCPacketBuilder& b)
+		{
+			b.beginMessage("/sys/frame_end", "ii").addInt32(frame).addInt32(encoder.messageCount() + 1).endMessage();
+		});
+
+		const auto& packets = encoder.end();
+		pendingFrames[frame] = Clock::now();
+
+		for (const auto& packet : packets)
+		{
+			bool ok;
+			if (useShm)
+			{
+				ok = shm.write(packet.data(), packet.size());
+			}
+			else
+			{
+				const auto sent = sendto(sendSocket, reinterpret_cast<const char*>(packet.data()), int(packet.size()), 0,
+					reinterpret_cast<const sockaddr*>(&target), sizeof(target));
+				ok = sent >= 0 && size_t(sent) == packet.size();
+			}
+
+			if (ok)
+			{
+				stats.packetsSent++;
+				stats.bytesSent += packet.size();
+			}
+			else
+			{
+				stats.sendErrors++;
+			}
+		}
+
+		stats.framesSent++;
+	};
+
+	if (!o.quiet)
+	{
+		std::printf("sending %d object(s) x %d channel(s) x %d sample(s) at %.1f fps to %s\n",
+			o.objects, o.channels, o.samples, o.fps,
+			useShm ? ("shm:" + o.shmName).c_str() : (o.host + ":" + std::to_string(o.port)).c_str());
+	}
+
+	const auto framePeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / o.fps));
+	const auto start = Clock::now();
+	auto nextFrame = start;
+	auto nextReport = start + std::chrono::seconds(1);
+	int32_t frame = 0;
+	uint64_t lastReportFrames = 0, lastReportAcks = 0;
+
+	for (;;)
+	{
+		const auto now = Clock::now();
+		const double elapsed = std::chrono::duration<double>(now - start).count();
+		if (o.duration > 0 && elapsed >= o.duration)
+			break;
+
+		if (now >= nextFrame)
+		{
+			for (int b = 0; b < o.burst; b++)
+				sendFrame(frame++, elapsed);
+
+			// A single message can't be split across packets
+			if (encoder.largestRejected() > 0)
+			{
+				std::fprintf(stderr, "a %zu byte message doesn't fit into %s of %zu bytes, reduce --samples or raise %s\n",
+					encoder.largestRejected(), useShm ? "a slot" : "a packet", o.maxPacket,
+					useShm ? "--slot-size" : "--max-packet");
+				return 1;
+			}
+
+			nextFrame += framePeriod * o.burst;
+			if (nextFrame < now)
+				nextFrame = now;
+		}
+
+		pollAcks();
+
+		if (!o.quiet && now >= nextReport)
+		{
+			std::printf("frames %llu (+%llu)  acks %llu (+%llu)  packets %llu  MB %.1f  errors %llu\n",
+				(unsigned long long)stats.framesSent, (unsigned long long)(stats.framesSent - lastReportFrames),
+				(unsigned long long)stats.acks, (unsigned long long)(stats.acks - lastReportAcks),
+				(unsigned long long)stats.packetsSent, double(stats.bytesSent) / (1024.0 * 1024.0),
+				(unsigned long long)stats.sendErrors);
+			lastReportFrames = stats.framesSent;
+			lastReportAcks = stats.acks;
+			nextReport += std::chrono::seconds(1);
+		}
+
+		std::this_thread::sleep_for(std::chrono::microseconds(200));
+	}
+
+	// Give the receiver a moment to acknowledge the last frames.
+	const auto drainEnd = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(o.ackTimeout));
+	while (ackSocket != kInvalidSocket && !pendingFrames.empty() && Clock::now() < drainEnd)
+	{
+		pollAcks();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	std::printf("\n");
+	std::printf("frames sent     %llu (%.1f fps)\n", (unsigned long long)stats.framesSent, double(stats.framesSent) / seconds);
+	std::printf("packets sent    %llu, %.1f MB, %llu error(s)\n",
+		(unsigned long long)stats.packetsSent, double(stats.bytesSent) / (1024.0 * 1024.0), (unsigned long long)stats.sendErrors);
+
+	if (ackSocket != kInvalidSocket)
+	{
+		std::printf("frames acked    %llu (%.1f%%)\n", (unsigned long long)stats.acks,
+			stats.framesSent ? 100.0 * double(stats.acks) / double(stats.framesSent) : 0.0);
+		std::printf("ack latency ms  p50 %.2f  p99 %.2f  max %.2f\n",
+			percentile(stats.latencies, 0.5), percentile(stats.latencies, 0.99), percentile(stats.latencies, 1.0));
+		closeSocket(ackSocket);
+	}
+
+	if (sendSocket != kInvalidSocket)
+		closeSocket(sendSocket);
+
+#if defined(_WIN32)
+	WSACleanup();
+#endif
+
+	return 0;
+}
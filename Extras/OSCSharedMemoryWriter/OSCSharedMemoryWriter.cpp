@@ -0,0 +1,357 @@
+#include "OSCSharedMemoryWriter.h"
+
+#include <chrono>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace oscactor
+{
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "atomic<uint64_t> must be layout compatible");
+
+static std::atomic<uint64_t>& asAtomic(uint64_t& value)
+{
+	return *reinterpret_cast<std::atomic<uint64_t>*>(&value);
+}
+
+static std::atomic<uint32_t>& asAtomic(uint32_t& value)
+{
+	return *reinterpret_cast<std::atomic<uint32_t>*>(&value);
+}
+
+static uint64_t makeGeneration()
+{
+	static std::atomic<uint64_t> counter(0);
+
+	const uint64_t now = uint64_t(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+	const uint64_t generation = now ^ (counter.fetch_add(1) * 0x9E3779B97F4A7C15ull);
+	return generation ? generation : 1;
+}
+
+#if !defined(_WIN32)
+// A previous writer (e.g. one that crashed) may have left the region linked while
+// readers still map it. Invalidate its header so they detach, then unlink it; the
+// new region is created from scratch and never resized under an existing mapping.
+static void retireRegion(const std::string& shmName)
+{
+	int fd = shm_open(shmName.c_str(), O_RDWR, 0);
+	if (fd < 0)
+		return;
+
+	struct stat st;
+	if (fstat(fd, &st) == 0 && size_t(st.st_size) >= sizeof(SharedMemoryHeader))
+	{
+		void* address = mmap(nullptr, sizeof(SharedMemoryHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (address != MAP_FAILED)
+		{
+			asAtomic(static_cast<SharedMemoryHeader*>(address)->Magic).store(0, std::memory_order_release);
+			munmap(address, sizeof(SharedMemoryHeader));
+		}
+	}
+
+	::close(fd);
+	shm_unlink(shmName.c_str());
+}
+#endif
+
+SharedMemoryWriter::~SharedMemoryWriter()
+{
+	close();
+}
+
+bool SharedMemoryWriter::open(const std::string& name, uint32_t slotCount, uint32_t slotSize)
+{
+	close();
+
+	if (name.empty() || slotCount == 0 || slotSize == 0)
+		return false;
+
+	const size_t size = SharedMemoryRegionSize(slotCount, slotSize);
+	void* address = nullptr;
+
+#if defined(_WIN32)
+	HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+		DWORD(uint64_t(size) >> 32), DWORD(size & 0xFFFFFFFF), name.c_str());
+	if (!mapping)
+		return false;
+
+	address = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+	if (!address)
+	{
+		CloseHandle(mapping);
+		return false;
+	}
+
+	MappingHandle = mapping;
+#else
+	const std::string shmName = "/" + name;
+	retireRegion(shmName);
+
+	int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+	if (fd < 0)
+		return false;
+
+	if (ftruncate(fd, off_t(size)) != 0)
+	{
+		::close(fd);
+		shm_unlink(shmName.c_str());
+		return false;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) == 0)
+	{
+		ShmDevice = uint64_t(st.st_dev);
+		ShmInode = uint64_t(st.st_ino);
+	}
+
+	address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+
+	if (address == MAP_FAILED)
+	{
+		shm_unlink(shmName.c_str());
+		return false;
+	}
+
+	ShmName = shmName;
+#endif
+
+	MappedSize = size;
+	Header = static_cast<SharedMemoryHeader*>(address);
+
+	// On Windows an existing mapping is reused as is; invalidate the header first
+	// so a reader attached to it drops it before the geometry changes.
+	asAtomic(Header->PublishedCount).store(0, std::memory_order_relaxed);
+	asAtomic(Header->Magic).store(0, std::memory_order_release);
+
+	std::memset(reinterpret_cast<uint8_t*>(Header) + sizeof(SharedMemoryHeader), 0, size - sizeof(SharedMemoryHeader));
+
+	Header->Version = kSharedMemoryVersion;
+	Header->SlotCount = slotCount;
+	Header->SlotSize = slotSize;
+	Header->Generation = makeGeneration();
+	asAtomic(Header->Magic).store(kSharedMemoryMagic, std::memory_order_release);
+
+	PendingIndex = 0;
+	bWriting = false;
+
+	return true;
+}
+
+void SharedMemoryWriter::close()
+{
+	if (!Header)
+		return;
+
+#if defined(_WIN32)
+	UnmapViewOfFile(Header);
+	CloseHandle(static_cast<HANDLE>(MappingHandle));
+	MappingHandle = nullptr;
+#else
+	munmap(Header, MappedSize);
+
+	// Another writer may have re-created the region under the same name meanwhile
+	int fd = shm_open(ShmName.c_str(), O_RDONLY, 0);
+	if (fd >= 0)
+	{
+		struct stat st;
+		const bool bOwned = fstat(fd, &st) == 0 && uint64_t(st.st_dev) == ShmDevice && uint64_t(st.st_ino) == ShmInode;
+		::close(fd);
+
+		if (bOwned)
+			shm_unlink(ShmName.c_str());
+	}
+
+	ShmName.clear();
+	ShmDevice = ShmInode = 0;
+#endif
+
+	Header = nullptr;
+	MappedSize = 0;
+	bWriting = false;
+}
+
+SharedMemorySlotHeader* SharedMemoryWriter::slot(uint64_t index) const
+{
+	uint8_t* base = reinterpret_cast<uint8_t*>(Header) + sizeof(SharedMemoryHeader);
+	return reinterpret_cast<SharedMemorySlotHeader*>(base + SharedMemorySlotStride(Header->SlotSize) * (index % Header->SlotCount));
+}
+
+uint8_t* SharedMemoryWriter::beginWrite()
+{
+	if (!Header || bWriting)
+		return nullptr;
+
+	PendingIndex = asAtomic(Header->PublishedCount).load(std::memory_order_relaxed);
+
+	SharedMemorySlotHeader* s = slot(PendingIndex);
+
+	// Mark the slot as being written; readers seeing an odd or unexpected
+	// sequence value skip it.
+	asAtomic(s->Sequence).store(PendingIndex * 2 + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	bWriting = true;
+	return reinterpret_cast<uint8_t*>(s + 1);
+}
+
+void SharedMemoryWriter::commitWrite(size_t size)
+{
+	if (!Header || !bWriting)
+		return;
+
+	SharedMemorySlotHeader* s = slot(PendingIndex);
+	s->Size = uint32_t(size < Header->SlotSize ? size : Header->SlotSize);
+
+	asAtomic(s->Sequence).store((PendingIndex + 1) * 2, std::memory_order_release);
+	asAtomic(Header->PublishedCount).store(PendingIndex + 1, std::memory_order_release);
+
+	bWriting = false;
+}
+
+bool SharedMemoryWriter::write(const void* data, size_t size)
+{
+	if (!Header || size > Header->SlotSize)
+		return false;
+
+	uint8_t* dst = beginWrite();
+	if (!dst)
+		return false;
+
+	std::memcpy(dst, data, size);
+	commitWrite(size);
+
+	return true;
+}
+
+// ===================================================================================
+
+void OSCPacketBuilder::writeU32(uint32_t value)
+{
+	Buffer.push_back(uint8_t(value >> 24));
+	Buffer.push_back(uint8_t(value >> 16));
+	Buffer.push_back(uint8_t(value >> 8));
+	Buffer.push_back(uint8_t(value));
+}
+
+void OSCPacketBuilder::writePaddedString(const std::string& value)
+{
+	Buffer.insert(Buffer.end(), value.begin(), value.end());
+	Buffer.push_back(0);
+	while (Buffer.size() % 4)
+		Buffer.push_back(0);
+}
+
+static void patchU32(std::vector<uint8_t>& buffer, size_t offset, uint32_t value)
+{
+	buffer[offset + 0] = uint8_t(value >> 24);
+	buffer[offset + 1] = uint8_t(value >> 16);
+	buffer[offset + 2] = uint8_t(value >> 8);
+	buffer[offset + 3] = uint8_t(value);
+}
+
+OSCPacketBuilder& OSCPacketBuilder::beginBundle(uint64_t timeTag)
+{
+	size_t sizeOffset = npos;
+	if (!BundleStack.empty())
+	{
+		sizeOffset = Buffer.size();
+		writeU32(0);
+	}
+
+	BundleStack.push_back(sizeOffset);
+
+	writePaddedString("#bundle");
+	writeU32(uint32_t(timeTag >> 32));
+	writeU32(uint32_t(timeTag));
+
+	return *this;
+}
+
+OSCPacketBuilder& OSCPacketBuilder::endBundle()
+{
+	if (BundleStack.empty())
+		return *this;
+
+	const size_t sizeOffset = BundleStack.back();
+	BundleStack.pop_back();
+
+	if (sizeOffset != npos)
+		patchU32(Buffer, sizeOffset, uint32_t(Buffer.size() - sizeOffset - 4));
+
+	return *this;
+}
+
+OSCPacketBuilder& OSCPacketBuilder::beginMessage(const std::string& address, const std::string& typeTags)
+{
+	MessageStart = npos;
+	if (!BundleStack.empty())
+	{
+		MessageStart = Buffer.size();
+		writeU32(0);
+	}
+
+	writePaddedString(address);
+	writePaddedString("," + typeTags);
+
+	return *this;
+}
+
+OSCPacketBuilder& OSCPacketBuilder::addFloat(float value)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	writeU32(bits);
+	return *this;
+}
+
+OSCPacketBuilder& OSCPacketBuilder::addInt32(int32_t value)
+{
+	writeU32(uint32_t(value));
+	return *this;
+}
+
+OSCPacketBuilder& OSCPacketBuilder::addString(const std::string& value)
+{
+	writePaddedString(value);
+	return *this;
+}
+
+OSCPacketBuilder& OSCPacketBuilder::endMessage()
+{
+	if (MessageStart != npos)
+		patchU32(Buffer, MessageStart, uint32_t(Buffer.size() - MessageStart - 4));
+
+	MessageStart = npos;
+	return *this;
+}
+
+OSCPacketBuilder& OSCPacketBuilder::message(const std::string& address, const float* values, size_t count)
+{
+	beginMessage(address, std::string(count, 'f'));
+	for (size_t i = 0; i < count; i++)
+		addFloat(values[i]);
+	return endMessage();
+}
+
+OSCPacketBuilder& OSCPacketBuilder::message(const std::string& address, int32_t value)
+{
+	return beginMessage(address, "i").addInt32(value).endMessage();
+}
+
+OSCPacketBuilder& OSCPacketBuilder::message(const std::string& address, bool value)
+{
+	return beginMessage(address, value ? "T" : "F").endMessage();
+}
+
+} // namespace oscactor
@@ -0,0 +1,148 @@
+// Standalone writer for the OSCActor shared-memory transport.
+//
+// Senders running on the same machine as Unreal (e.g. a TouchDesigner C++ CHOP)
+// can publish the exact OSC packet bytes they would send over UDP into a named
+// shared-memory ring buffer instead. The OSCActor plugin maps the same region
+// and feeds every published packet into the regular OSC dispatch.
+//
+// This library has no dependencies besides the C++ standard library and the
+// platform shared-memory API (Win32 file mappings / POSIX shm_open).
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace oscactor
+{
+
+// Memory layout. Must stay in sync with Source/OSCActor/Private/OSCActorSharedMemory.h
+
+static constexpr uint32_t kSharedMemoryMagic = 0x5343534F; // 'OSCS'
+static constexpr uint32_t kSharedMemoryVersion = 1;
+
+struct SharedMemoryHeader
+{
+	uint32_t Magic;
+	uint32_t Version;
+	uint32_t SlotCount;
+	uint32_t SlotSize;       // payload capacity of a single slot in bytes
+	uint64_t PublishedCount; // number of packets published so far
+	uint64_t Generation;     // non-zero id of this incarnation of the region, new on every open()
+	uint8_t Padding[32];
+};
+static_assert(sizeof(SharedMemoryHeader) == 64, "SharedMemoryHeader must be 64 bytes");
+
+struct SharedMemorySlotHeader
+{
+	// Seqlock / generation counter. Odd while the slot is being written,
+	// 2 * (PacketIndex + 1) once packet PacketIndex has been published.
+	uint64_t Sequence;
+	uint32_t Size;
+	uint32_t Reserved;
+};
+static_assert(sizeof(SharedMemorySlotHeader) == 16, "SharedMemorySlotHeader must be 16 bytes");
+
+inline size_t SharedMemorySlotStride(uint32_t SlotSize)
+{
+	return (sizeof(SharedMemorySlotHeader) + SlotSize + 63) & ~size_t(63);
+}
+
+inline size_t SharedMemoryRegionSize(uint32_t SlotCount, uint32_t SlotSize)
+{
+	return sizeof(SharedMemoryHeader) + SharedMemorySlotStride(SlotSize) * SlotCount;
+}
+
+// ===================================================================================
+
+class SharedMemoryWriter
+{
+public:
+
+	SharedMemoryWriter() = default;
+	~SharedMemoryWriter();
+
+	SharedMemoryWriter(const SharedMemoryWriter&) = delete;
+	SharedMemoryWriter& operator=(const SharedMemoryWriter&) = delete;
+
+	// Creates (or re-creates) the named region. SlotSize bounds the largest
+	// packet that can be published; SlotCount is how many packets the reader
+	// may fall behind before older ones are overwritten.
+	bool open(const std::string& name, uint32_t slotCount = 8, uint32_t slotSize = 4 * 1024 * 1024);
+	void close();
+
+	bool isOpen() const { return Header != nullptr; }
+	uint32_t slotSize() const { return Header ? Header->SlotSize : 0; }
+
+	// Copies one OSC packet (message or bundle) into the next slot.
+	bool write(const void* data, size_t size);
+
+	// Zero-copy variant: encode straight into the slot returned by beginWrite()
+	// (at most slotSize() bytes), then publish it with commitWrite().
+	uint8_t* beginWrite();
+	void commitWrite(size_t size);
+
+private:
+
+	SharedMemorySlotHeader* slot(uint64_t index) const;
+
+	SharedMemoryHeader* Header = nullptr;
+	size_t MappedSize = 0;
+	uint64_t PendingIndex = 0;
+	bool bWriting = false;
+
+#if defined(_WIN32)
+	void* MappingHandle = nullptr;
+#else
+	std::string ShmName;
+
+	// Identity of the object we created, so close() leaves a newer writer's region alone
+	uint64_t ShmDevice = 0;
+	uint64_t ShmInode = 0;
+#endif
+};
+
+// ===================================================================================
+
+// Minimal OSC 1.0 encoder, enough to produce the packets the OSCActor plugin
+// understands (float / int32 / bool / string arguments, optionally wrapped in a bundle).
+
+class OSCPacketBuilder
+{
+public:
+
+	void clear() { Buffer.clear(); BundleStack.clear(); MessageStart = npos; }
+
+	OSCPacketBuilder& beginBundle(uint64_t timeTag = 1);
+	OSCPacketBuilder& endBundle();
+
+	OSCPacketBuilder& beginMessage(const std::string& address, const std::string& typeTags);
+	OSCPacketBuilder& addFloat(float value);
+	OSCPacketBuilder& addInt32(int32_t value);
+	OSCPacketBuilder& addString(const std::string& value);
+	OSCPacketBuilder& endMessage();
+
+	// Convenience: a whole message with N float arguments.
+	OSCPacketBuilder& message(const std::string& address, const float* values, size_t count);
+	OSCPacketBuilder& message(const std::string& address, int32_t value);
+	OSCPacketBuilder& message(const std::string& address, bool value);
+
+	const std::vector<uint8_t>& data() const { return Buffer; }
+	size_t size() const { return Buffer.size(); }
+
+private:
+
+	static constexpr size_t npos = size_t(-1);
+
+	void writeU32(uint32_t value);
+	void writePaddedString(const std::string& value);
+
+	std::vector<uint8_t> Buffer;
+	std::vector<size_t> BundleStack;
+	size_t MessageStart = npos;
+};
+
+} // namespace oscactor
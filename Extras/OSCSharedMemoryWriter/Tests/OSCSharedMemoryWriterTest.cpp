@@ -0,0 +1,361 @@
+// Round-trip test for the shared-memory writer: encodes packets with
+// OSCPacketBuilder, publishes them with SharedMemoryWriter, maps the region
+// the way a reader would and checks the layout, seqlock values and contents.
+
+#include "OSCSharedMemoryWriter.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace oscactor;
+
+static int failures = 0;
+
+#define CHECK(cond) \
+	do { if (!(cond)) { std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while (0)
+
+// ===================================================================================
+
+// Read-only view of a named region, mapped independently of the writer.
+class ReaderMapping
+{
+public:
+
+	bool open(const std::string& name)
+	{
+#if defined(_WIN32)
+		Handle = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+		if (!Handle)
+			return false;
+
+		Address = static_cast<const uint8_t*>(MapViewOfFile(Handle, FILE_MAP_READ, 0, 0, 0));
+		MEMORY_BASIC_INFORMATION info;
+		if (Address && VirtualQuery(Address, &info, sizeof(info)))
+			Size = info.RegionSize;
+#else
+		int fd = shm_open(("/" + name).c_str(), O_RDONLY, 0);
+		if (fd < 0)
+			return false;
+
+		struct stat st;
+		if (fstat(fd, &st) == 0)
+		{
+			Size = size_t(st.st_size);
+			void* address = mmap(nullptr, Size, PROT_READ, MAP_SHARED, fd, 0);
+			Address = address == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(address);
+		}
+		::close(fd);
+#endif
+		return Address != nullptr;
+	}
+
+	~ReaderMapping()
+	{
+#if defined(_WIN32)
+		if (Address)
+			UnmapViewOfFile(Address);
+		if (Handle)
+			CloseHandle(Handle);
+#else
+		if (Address)
+			munmap(const_cast<uint8_t*>(Address), Size);
+#endif
+	}
+
+	const SharedMemoryHeader& header() const { return *reinterpret_cast<const SharedMemoryHeader*>(Address); }
+
+	const SharedMemorySlotHeader& slot(uint32_t index) const
+	{
+		return *reinterpret_cast<const SharedMemorySlotHeader*>(
+			Address + sizeof(SharedMemoryHeader) + SharedMemorySlotStride(header().SlotSize) * index);
+	}
+
+	std::vector<uint8_t> payload(uint32_t index) const
+	{
+		const uint8_t* data = reinterpret_cast<const uint8_t*>(&slot(index) + 1);
+		return std::vector<uint8_t>(data, data + slot(index).Size);
+	}
+
+	size_t Size = 0;
+
+private:
+
+	const uint8_t* Address = nullptr;
+#if defined(_WIN32)
+	HANDLE Handle = nullptr;
+#endif
+};
+
+// ===================================================================================
+
+// Minimal OSC decoder, independent of OSCPacketBuilder.
+
+struct DecodedMessage
+{
+	std::string address;
+	std::string tags;
+	std::vector<float> floats;
+	std::vector<int32_t> ints;
+	std::vector<std::string> strings;
+};
+
+static uint32_t readU32(const uint8_t* p)
+{
+	return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+static bool readString(const uint8_t* data, size_t size, size_t& pos, std::string& out)
+{
+	const size_t start = pos;
+	while (pos < size && data[pos] != 0)
+		pos++;
+	if (pos >= size)
+		return false;
+
+	out.assign(reinterpret_cast<const char*>(data + start), pos - start);
+	pos = (pos + 4) & ~size_t(3);
+	return pos <= size;
+}
+
+static bool decode(const uint8_t* data, size_t size, std::vector<DecodedMessage>& out)
+{
+	if (size >= 16 && std::memcmp(data, "#bundle", 8) == 0)
+	{
+		size_t pos = 16;
+		while (pos + 4 <= size)
+		{
+			const size_t elementSize = readU32(data + pos);
+			pos += 4;
+			if (pos + elementSize > size || !decode(data + pos, elementSize, out))
+				return false;
+			pos += elementSize;
+		}
+		return pos == size;
+	}
+
+	DecodedMessage m;
+	size_t pos = 0;
+	if (!readString(data, size, pos, m.address) || !readString(data, size, pos, m.tags) || m.tags.empty() || m.tags[0] != ',')
+		return false;
+
+	for (size_t i = 1; i < m.tags.size(); i++)
+	{
+		const char tag = m.tags[i];
+		if (tag == 'f' || tag == 'i')
+		{
+			if (pos + 4 > size)
+				return false;
+
+			const uint32_t bits = readU32(data + pos);
+			pos += 4;
+
+			if (tag == 'f')
+			{
+				float value;
+				std::memcpy(&value, &bits, sizeof(value));
+				m.floats.push_back(value);
+			}
+			else
+			{
+				m.ints.push_back(int32_t(bits));
+			}
+		}
+		else if (tag == 's')
+		{
+			std::string value;
+			if (!readString(data, size, pos, value))
+				return false;
+			m.strings.push_back(value);
+		}
+		else if (tag != 'T' && tag != 'F')
+		{
+			return false;
+		}
+	}
+
+	out.push_back(m);
+	return pos == size;
+}
+
+// ===================================================================================
+
+static std::vector<uint8_t> makeFramePacket(int32_t frame)
+{
+	const float trs[9] = { 1, 2, 3, 0, 90, 0, 1, 1, 1 };
+
+	OSCPacketBuilder b;
+	b.beginBundle();
+	b.message("/sys/frame_number", frame);
+	b.message("/obj/a/active", true);
+	b.message("/obj/a/TRS", trs, 9);
+	b.beginMessage("/obj/a/name", "s").addString("abc").endMessage();
+	b.endBundle();
+	return b.data();
+}
+
+static void testPacketBuilder()
+{
+	const std::vector<uint8_t> packet = makeFramePacket(42);
+	CHECK(packet.size() % 4 == 0);
+
+	std::vector<DecodedMessage> messages;
+	CHECK(decode(packet.data(), packet.size(), messages));
+	CHECK(messages.size() == 4);
+	if (messages.size() != 4)
+		return;
+
+	CHECK(messages[0].address == "/sys/frame_number" && messages[0].tags == ",i");
+	CHECK(messages[0].ints.size() == 1 && messages[0].ints[0] == 42);
+	CHECK(messages[1].address == "/obj/a/active" && messages[1].tags == ",T");
+	CHECK(messages[2].address == "/obj/a/TRS" && messages[2].tags == ",fffffffff");
+	CHECK(messages[2].floats.size() == 9 && messages[2].floats[0] == 1 && messages[2].floats[4] == 90);
+	CHECK(messages[3].strings.size() == 1 && messages[3].strings[0] == "abc");
+
+	// Nested bundles carry their element size
+	OSCPacketBuilder nested;
+	nested.beginBundle().beginBundle().message("/x", int32_t(1)).endBundle().endBundle();
+	messages.clear();
+	CHECK(decode(nested.data().data(), nested.size(), messages));
+	CHECK(messages.size() == 1 && messages[0].address == "/x");
+}
+
+static void testRing(const std::string& name)
+{
+	const uint32_t slotCount = 4;
+	const uint32_t slotSize = 256;
+
+	SharedMemoryWriter writer;
+	CHECK(writer.open(name, slotCount, slotSize));
+	CHECK(writer.slotSize() == slotSize);
+
+	ReaderMapping reader;
+	CHECK(reader.open(name));
+	if (!writer.isOpen() || !reader.Size)
+		return;
+
+	CHECK(reader.Size >= SharedMemoryRegionSize(slotCount, slotSize));
+	CHECK(reader.header().Magic == kSharedMemoryMagic);
+	CHECK(reader.header().Version == kSharedMemoryVersion);
+	CHECK(reader.header().SlotCount == slotCount);
+	CHECK(reader.header().SlotSize == slotSize);
+	CHECK(reader.header().PublishedCount == 0);
+	CHECK(reader.header().Generation != 0);
+	CHECK(SharedMemorySlotStride(slotSize) % 64 == 0);
+
+	// First packet lands in slot 0 with sequence 2 * (0 + 1)
+	const std::vector<uint8_t> first = makeFramePacket(0);
+	CHECK(first.size() <= slotSize);
+	CHECK(writer.write(first.data(), first.size()));
+	CHECK(reader.header().PublishedCount == 1);
+	CHECK(reader.slot(0).Sequence == 2);
+	CHECK(reader.slot(0).Size == first.size());
+	CHECK(reader.payload(0) == first);
+
+	std::vector<DecodedMessage> messages;
+	const std::vector<uint8_t> stored = reader.payload(0);
+	CHECK(decode(stored.data(), stored.size(), messages));
+	CHECK(messages.size() == 4 && messages[0].ints.size() == 1 && messages[0].ints[0] == 0);
+
+	// Oversized packets are rejected without publishing
+	const std::vector<uint8_t> tooBig(slotSize + 4, 0);
+	CHECK(!writer.write(tooBig.data(), tooBig.size()));
+	CHECK(reader.header().PublishedCount == 1);
+
+	// The sequence is odd while a slot is being written
+	uint8_t* dst = writer.beginWrite();
+	CHECK(dst != nullptr);
+	CHECK(reader.slot(1).Sequence == 3);
+	CHECK(reader.header().PublishedCount == 1);
+	const std::vector<uint8_t> second = makeFramePacket(1);
+	std::memcpy(dst, second.data(), second.size());
+	writer.commitWrite(second.size());
+	CHECK(reader.slot(1).Sequence == 4);
+	CHECK(reader.header().PublishedCount == 2);
+
+	// Wrap around: packets 4 and 5 overwrite slots 0 and 1
+	std::vector<std::vector<uint8_t>> packets = { first, second };
+	for (int32_t frame = 2; frame < 6; frame++)
+	{
+		packets.push_back(makeFramePacket(frame));
+		CHECK(writer.write(packets.back().data(), packets.back().size()));
+	}
+
+	CHECK(reader.header().PublishedCount == 6);
+	for (uint32_t index = 2; index < 6; index++)
+	{
+		const uint32_t s = index % slotCount;
+		CHECK(reader.slot(s).Sequence == uint64_t(index + 1) * 2);
+		CHECK(reader.payload(s) == packets[index]);
+
+		messages.clear();
+		const std::vector<uint8_t> bytes = reader.payload(s);
+		CHECK(decode(bytes.data(), bytes.size(), messages));
+		CHECK(!messages.empty() && messages[0].ints.size() == 1 && messages[0].ints[0] == int32_t(index));
+	}
+
+#if !defined(_WIN32)
+	// A restarted writer retires the region readers still map instead of resizing it.
+	// Windows keeps a named mapping alive while any handle is open, so this is POSIX only.
+	SharedMemoryWriter restarted;
+	CHECK(restarted.open(name, slotCount * 2, slotSize * 2));
+	CHECK(reader.header().Magic == 0);
+	CHECK(reader.header().SlotCount == slotCount);
+
+	ReaderMapping reattached;
+	CHECK(reattached.open(name));
+	if (reattached.Size)
+	{
+		CHECK(reattached.header().Magic == kSharedMemoryMagic);
+		CHECK(reattached.header().SlotCount == slotCount * 2);
+		CHECK(reattached.header().SlotSize == slotSize * 2);
+		CHECK(reattached.header().PublishedCount == 0);
+		CHECK(reattached.header().Generation != 0);
+		CHECK(reattached.header().Generation != reader.header().Generation);
+	}
+
+	// Closing the older writer must not unlink the region the restarted one owns
+	writer.close();
+	ReaderMapping afterClose;
+	CHECK(afterClose.open(name));
+	if (afterClose.Size)
+		CHECK(afterClose.header().SlotCount == slotCount * 2);
+
+	// The owner does unlink it
+	restarted.close();
+	ReaderMapping afterOwnerClose;
+	CHECK(!afterOwnerClose.open(name));
+#endif
+}
+
+int main()
+{
+#if defined(_WIN32)
+	const std::string name = "OSCSharedMemoryWriterTest" + std::to_string(GetCurrentProcessId());
+#else
+	const std::string name = "OSCSharedMemoryWriterTest" + std::to_string(getpid());
+#endif
+
+	testPacketBuilder();
+	testRing(name);
+
+	if (failures)
+	{
+		std::fprintf(stderr, "%d check(s) failed\n", failures);
+		return 1;
+	}
+
+	std::printf("all checks passed\n");
+	return 0;
+}
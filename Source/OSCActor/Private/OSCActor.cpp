@@ -12,6 +12,7 @@ static float getSample(const TArray<float>& c, int index, float default_value =
 // ===================================================================================
 
 UOSCActorComponent::UOSCActorComponent()
+	: MaterialBindings(nullptr)
 {
 	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.bStartWithTickEnabled = true;
@@ -19,6 +20,26 @@ UOSCActorComponent::UOSCActorComponent()
 	bTickInEditor = true;
 }
 
+void UOSCActorComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	UOSCActorSubsystem* S = GEngine ? GEngine->GetEngineSubsystem<UOSCActorSubsystem>() : nullptr;
+	if (S)
+		S->UpdateActorReference(this);
+}
+
+// Also runs when the owner is deleted in the editor, where the component lingers in
+// the transaction buffer and BeginDestroy may never come
+void UOSCActorComponent::OnUnregister()
+{
+	UOSCActorSubsystem* S = GEngine ? GEngine->GetEngineSubsystem<UOSCActorSubsystem>() : nullptr;
+	if (S)
+		S->RemoveActorReference(this);
+
+	Super::OnUnregister();
+}
+
 void UOSCActorComponent::BeginDestroy()
 {
 	UOSCActorSubsystem* S = GEngine->GetEngineSubsystem<UOSCActorSubsystem>();
@@ -38,6 +59,17 @@ void UOSCActorComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 		S->UpdateActorReference(this);
 }
 
+#if WITH_EDITOR
+void UOSCActorComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Edits inside a row report the row's field as property, the table as member property
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UOSCActorComponent, PropertyBindings))
+		PropertyBindingsVersion++;
+}
+#endif
+
 float UOSCActorComponent::GetOSCParam(const FString& Key, float DefaultValue)
 {
 	if (!Params.Contains(Key))
@@ -59,82 +91,188 @@ const TArray<float>& UOSCActorComponent::GetOSCMultiSampleParam(const FString& K
 	return s.Samples;
 }
 
-void UOSCActorComponent::UpdateInstancedStaticMesh(UInstancedStaticMeshComponent* InstancedStaticMesh,
-	TArray<FString> InCustomDataChannels)
+TArrayView<const float> UOSCActorComponent::GetOSCParamHistoryView(const FString& Key, TArrayView<const double>* OutTimestamps) const
 {
-TArray<FInstancedStaticMeshInstanceData> InstanceData;
+	const FParamHistory* History = ParamHistory.Find(Key);
+	if (!History)
+	{
+		if (OutTimestamps)
+			*OutTimestamps = TArrayView<const double>();
+		return TArrayView<const float>();
+	}
 
-	const TArray<float>& tx = GetOSCMultiSampleParam("tx");
-	const TArray<float>& ty = GetOSCMultiSampleParam("ty");
-	const TArray<float>& tz = GetOSCMultiSampleParam("tz");
+	History->UpdateWindow(GFrameCounter);
 
-	const TArray<float>& rx = GetOSCMultiSampleParam("rx");
-	const TArray<float>& ry = GetOSCMultiSampleParam("ry");
-	const TArray<float>& rz = GetOSCMultiSampleParam("rz");
+	if (OutTimestamps)
+		*OutTimestamps = History->GetTimestamps();
+	return History->GetValues();
+}
 
-	const TArray<float>& sx = GetOSCMultiSampleParam("sx");
-	const TArray<float>& sy = GetOSCMultiSampleParam("sy");
-	const TArray<float>& sz = GetOSCMultiSampleParam("sz");
+int32 UOSCActorComponent::GetOSCParamHistory(const FString& Key, TArray<float>& OutValues, TArray<double>& OutTimestamps) const
+{
+	TArrayView<const double> Timestamps;
+	TArrayView<const float> Values = GetOSCParamHistoryView(Key, &Timestamps);
 
-	const TArray<float>& vx = GetOSCMultiSampleParam("vx");
-	const TArray<float>& vy = GetOSCMultiSampleParam("vy");
-	const TArray<float>& vz = GetOSCMultiSampleParam("vz");
+	OutValues.Reset(Values.Num());
+	OutValues.Append(Values.GetData(), Values.Num());
 
-	const TArray<float>& ltx = GetOSCMultiSampleParam("ltx");
-	const TArray<float>& lty = GetOSCMultiSampleParam("lty");
-	const TArray<float>& ltz = GetOSCMultiSampleParam("ltz");
+	OutTimestamps.Reset(Timestamps.Num());
+	OutTimestamps.Append(Timestamps.GetData(), Timestamps.Num());
 
-	const TArray<float>& lrx = GetOSCMultiSampleParam("lrx");
-	const TArray<float>& lry = GetOSCMultiSampleParam("lry");
-	const TArray<float>& lrz = GetOSCMultiSampleParam("lrz");
+	return Values.Num();
+}
 
-	const TArray<float>& lsx = GetOSCMultiSampleParam("lsx");
-	const TArray<float>& lsy = GetOSCMultiSampleParam("lsy");
-	const TArray<float>& lsz = GetOSCMultiSampleParam("lsz");
+void UOSCActorComponent::AddBoundMaterial(UMaterialInstanceDynamic* Material)
+{
+	if (IsValid(Material))
+		BoundMaterials.AddUnique(Material);
+}
 
-	TArray<TArray<float>> SrcCustomDataChannels;
-	for (int i = 0; i < InCustomDataChannels.Num(); i++)
-	{
-		const TArray<float>& a = GetOSCMultiSampleParam(InCustomDataChannels[i]);
-		
-		if (a.Num() != MultiSampleNum)
-		{
-			// UE_LOG(LogTemp, Log, TEXT("Invalid Channel Name: %s"), *InCustomDataChannels[i]);
-			continue;
-		}
+void UOSCActorComponent::RemoveBoundMaterial(UMaterialInstanceDynamic* Material)
+{
+	BoundMaterials.Remove(Material);
+}
 
-		SrcCustomDataChannels.Add(a);
+void UOSCActorComponent::ApplyMaterialBindings()
+{
+	if (!MaterialBindings)
+	{
+		MaterialBindingState.Reset();
+		return;
 	}
 
-	const bool hasDirection = (vx.Num() > 0) && (vy.Num() > 0) && (vz.Num() > 0);
-	const bool hasLocalTranslation = (ltx.Num() > 0) || (lty.Num() > 0) || (ltz.Num() > 0);
-	const bool hasLocalRotation = (lrx.Num() > 0) || (lry.Num() > 0) || (lrz.Num() > 0);
-	const bool hasLocalScale = (lsx.Num() > 0) || (lsy.Num() > 0) || (lsz.Num() > 0);
+	MaterialBindingState.Apply(GetWorld(), MaterialBindings, BoundMaterials, Params);
+}
 
-	InstanceData.SetNum(MultiSampleNum);
+void UOSCActorComponent::RefreshPropertyBindings()
+{
+	PropertyBindingsVersion++;
+}
 
-	InstancedStaticMesh->SetSimulatePhysics(false);
-	InstancedStaticMesh->DestroyPhysicsState();
-	
-	if (InstancedStaticMesh->GetInstanceCount() != MultiSampleNum)
-	{
-		while (InstancedStaticMesh->GetInstanceCount() < MultiSampleNum) {
-			FTransform T;
-			InstancedStaticMesh->AddInstance(T);
-		}
+void UOSCActorComponent::ApplyPropertyBindings()
+{
+	if (PropertyBindings.Num() == 0)
+		return;
 
-		while (InstancedStaticMesh->GetInstanceCount() > MultiSampleNum)
+	PropertyBindingState.Apply(GetOwner(), PropertyBindings, PropertyBindingsVersion, Params, MultiSampleParams);
+}
+
+void FChannelData::GetDirtyRuns(const TMap<FString, FChannelData>& Channels, int32 Num, TArray<FIntPoint>& OutRuns)
+{
+	static const int32 MERGE_GAP = 4;
+
+	OutRuns.Reset();
+	if (Num <= 0)
+		return;
+
+	TBitArray<> Merged(false, Num);
+
+	for (const auto& It : Channels)
+	{
+		const FChannelData& Data = It.Value;
+		if (Data.bAllDirty)
 		{
-			InstancedStaticMesh->RemoveInstance(0);
+			OutRuns.Add(FIntPoint(0, Num));
+			return;
 		}
+
+		for (TConstSetBitIterator<> Bit(Data.DirtyBits); Bit && Bit.GetIndex() < Num; ++Bit)
+			Merged[Bit.GetIndex()] = true;
+	}
+
+	for (TConstSetBitIterator<> Bit(Merged); Bit; ++Bit)
+	{
+		const int32 i = Bit.GetIndex();
+		if (OutRuns.Num() > 0 && i - OutRuns.Last().Y <= MERGE_GAP)
+			OutRuns.Last().Y = i + 1;
+		else
+			OutRuns.Add(FIntPoint(i, i + 1));
 	}
+}
 
-	InstancedStaticMesh->NumCustomDataFloats = InCustomDataChannels.Num();
-	InstancedStaticMesh->PerInstanceSMCustomData.SetNum(InstancedStaticMesh->NumCustomDataFloats * MultiSampleNum);
+bool UOSCActorComponent::GetMultiSampleDirtyRuns(TArray<FIntPoint>& OutRuns) const
+{
+	FChannelData::GetDirtyRuns(MultiSampleParams, MultiSampleNum, OutRuns);
+	return OutRuns.Num() > 0;
+}
 
-	float* CustomData = InstancedStaticMesh->PerInstanceSMCustomData.GetData();
+bool UOSCActorComponent::GetMultiSampleDirtyRange(int32& OutBegin, int32& OutEnd) const
+{
+	TArray<FIntPoint> Runs;
+	FChannelData::GetDirtyRuns(MultiSampleParams, MultiSampleNum, Runs);
 
-	for (int i = 0; i < MultiSampleNum; i++)
+	OutBegin = Runs.Num() > 0 ? Runs[0].X : 0;
+	OutEnd = Runs.Num() > 0 ? Runs.Last().Y : 0;
+
+	return OutBegin < OutEnd;
+}
+
+// Transform channels shared by every instanced mesh update
+struct FInstanceTransformChannels
+{
+	const TArray<float>& tx;
+	const TArray<float>& ty;
+	const TArray<float>& tz;
+
+	const TArray<float>& rx;
+	const TArray<float>& ry;
+	const TArray<float>& rz;
+
+	const TArray<float>& sx;
+	const TArray<float>& sy;
+	const TArray<float>& sz;
+
+	const TArray<float>& vx;
+	const TArray<float>& vy;
+	const TArray<float>& vz;
+
+	const TArray<float>& ltx;
+	const TArray<float>& lty;
+	const TArray<float>& ltz;
+
+	const TArray<float>& lrx;
+	const TArray<float>& lry;
+	const TArray<float>& lrz;
+
+	const TArray<float>& lsx;
+	const TArray<float>& lsy;
+	const TArray<float>& lsz;
+
+	bool hasDirection;
+	bool hasLocalTranslation;
+	bool hasLocalRotation;
+	bool hasLocalScale;
+
+	FInstanceTransformChannels(UOSCActorComponent* C)
+		: tx(C->GetOSCMultiSampleParam("tx"))
+		, ty(C->GetOSCMultiSampleParam("ty"))
+		, tz(C->GetOSCMultiSampleParam("tz"))
+		, rx(C->GetOSCMultiSampleParam("rx"))
+		, ry(C->GetOSCMultiSampleParam("ry"))
+		, rz(C->GetOSCMultiSampleParam("rz"))
+		, sx(C->GetOSCMultiSampleParam("sx"))
+		, sy(C->GetOSCMultiSampleParam("sy"))
+		, sz(C->GetOSCMultiSampleParam("sz"))
+		, vx(C->GetOSCMultiSampleParam("vx"))
+		, vy(C->GetOSCMultiSampleParam("vy"))
+		, vz(C->GetOSCMultiSampleParam("vz"))
+		, ltx(C->GetOSCMultiSampleParam("ltx"))
+		, lty(C->GetOSCMultiSampleParam("lty"))
+		, ltz(C->GetOSCMultiSampleParam("ltz"))
+		, lrx(C->GetOSCMultiSampleParam("lrx"))
+		, lry(C->GetOSCMultiSampleParam("lry"))
+		, lrz(C->GetOSCMultiSampleParam("lrz"))
+		, lsx(C->GetOSCMultiSampleParam("lsx"))
+		, lsy(C->GetOSCMultiSampleParam("lsy"))
+		, lsz(C->GetOSCMultiSampleParam("lsz"))
+	{
+		hasDirection = (vx.Num() > 0) && (vy.Num() > 0) && (vz.Num() > 0);
+		hasLocalTranslation = (ltx.Num() > 0) || (lty.Num() > 0) || (ltz.Num() > 0);
+		hasLocalRotation = (lrx.Num() > 0) || (lry.Num() > 0) || (lrz.Num() > 0);
+		hasLocalScale = (lsx.Num() > 0) || (lsy.Num() > 0) || (lsz.Num() > 0);
+	}
+
+	FMatrix GetInstanceTransform(int i) const
 	{
 		FMatrix T = FMatrix::Identity;
 
@@ -201,16 +339,257 @@ TArray<FInstancedStaticMeshInstanceData> InstanceData;
 		static const FMatrix ROT_YAW_90 = FRotationMatrix::Make(FRotator(0, -90, 0));
 		static const FMatrix ROT_YAW_90_T = FRotationMatrix::Make(FRotator(0, 90, 0));
 		
-		InstanceData[i].Transform = ROT_YAW_90_T * UOSCActorFunctionLibrary::ConvertGLtoUE4Matrix(T) * ROT_YAW_90;
+		return ROT_YAW_90_T * UOSCActorFunctionLibrary::ConvertGLtoUE4Matrix(T) * ROT_YAW_90;
+	}
+};
+
+// Sets up physics, instance count and custom data size. Returns true if the layout changed.
+static bool PrepareInstancedStaticMesh(UInstancedStaticMeshComponent* InstancedStaticMesh, int Num, int NumCustomDataFloats, bool bKeepInstancePhysics)
+{
+	if (bKeepInstancePhysics)
+	{
+		// Keep the instance bodies alive and move them kinematically instead of
+		// tearing the physics state down every update.
+		if (InstancedStaticMesh->IsSimulatingPhysics())
+			InstancedStaticMesh->SetSimulatePhysics(false);
+
+		if (!InstancedStaticMesh->IsPhysicsStateCreated())
+			InstancedStaticMesh->RecreatePhysicsState();
+	}
+	else
+	{
+		InstancedStaticMesh->SetSimulatePhysics(false);
+		InstancedStaticMesh->DestroyPhysicsState();
+	}
+	
+	// Bodies are only created / destroyed here, when the instance count changes
+	const int InstanceCount = InstancedStaticMesh->GetInstanceCount();
+	const bool bLayoutChanged = InstanceCount != Num
+		|| InstancedStaticMesh->NumCustomDataFloats != NumCustomDataFloats;
+
+	if (InstanceCount < Num)
+	{
+		TArray<FTransform> NewInstances;
+		NewInstances.SetNum(Num - InstanceCount);
+		InstancedStaticMesh->AddInstances(NewInstances, false);
+	}
+	else if (InstanceCount > Num)
+	{
+		TArray<int32> RemovedInstances;
+		for (int i = InstanceCount - 1; i >= Num; i--)
+			RemovedInstances.Add(i);
+		InstancedStaticMesh->RemoveInstances(RemovedInstances);
+	}
+
+	InstancedStaticMesh->NumCustomDataFloats = NumCustomDataFloats;
+	InstancedStaticMesh->PerInstanceSMCustomData.SetNum(NumCustomDataFloats * Num);
+
+	return bLayoutChanged;
+}
+
+// Pushes InstanceData and the already written custom data of [StartIndex, StartIndex + Num).
+// A full update recreates the render state; a partial one only sends the changed instances.
+static void CommitInstancedStaticMesh(UInstancedStaticMeshComponent* InstancedStaticMesh, int StartIndex,
+	TArray<FInstancedStaticMeshInstanceData>& InstanceData, bool bKeepInstancePhysics, bool bFullUpdate)
+{
+	if (bKeepInstancePhysics)
+	{
+		// Batched teleport of the instance bodies along with the render data
+		TArray<FTransform> Transforms;
+		Transforms.SetNum(InstanceData.Num());
+		for (int i = 0; i < InstanceData.Num(); i++)
+			Transforms[i] = FTransform(InstanceData[i].Transform);
+
+		InstancedStaticMesh->BatchUpdateInstancesTransforms(StartIndex, Transforms, false, bFullUpdate, true);
+	}
+	else
+	{
+		InstancedStaticMesh->BatchUpdateInstancesData(StartIndex, InstanceData.Num(), InstanceData.GetData(), bFullUpdate);
+	}
+
+	if (bFullUpdate)
+		return;
+
+	// Custom data was written in place, record it for the instance update as well
+	const int32 NumCustomDataFloats = InstancedStaticMesh->NumCustomDataFloats;
+	if (NumCustomDataFloats > 0)
+	{
+		TArray<float> Values;
+		for (int i = StartIndex; i < StartIndex + InstanceData.Num(); i++)
+		{
+			Values.Reset(NumCustomDataFloats);
+			Values.Append(InstancedStaticMesh->PerInstanceSMCustomData.GetData() + i * NumCustomDataFloats, NumCustomDataFloats);
+			InstancedStaticMesh->SetCustomData(i, Values, false);
+		}
+	}
+
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+	InstancedStaticMesh->MarkRenderInstancesDirty();
+#else
+	InstancedStaticMesh->MarkRenderStateDirty();
+#endif
+}
+
+void UOSCActorComponent::GetCustomDataChannels(const TArray<FString>& InCustomDataChannels, TArray<const TArray<float>*>& OutChannels)
+{
+	OutChannels.Reset(InCustomDataChannels.Num());
+
+	for (int i = 0; i < InCustomDataChannels.Num(); i++)
+	{
+		const TArray<float>& a = GetOSCMultiSampleParam(InCustomDataChannels[i]);
+		
+		if (a.Num() != MultiSampleNum)
+		{
+			// UE_LOG(LogTemp, Log, TEXT("Invalid Channel Name: %s"), *InCustomDataChannels[i]);
+			continue;
+		}
+
+		OutChannels.Add(&a);
+	}
+}
+
+void UOSCActorComponent::UpdateInstancedStaticMesh(UInstancedStaticMeshComponent* InstancedStaticMesh,
+	TArray<FString> InCustomDataChannels)
+{
+	if (!IsValid(InstancedStaticMesh))
+		return;
+
+	TArray<FInstancedStaticMeshInstanceData> InstanceData;
+
+	const FInstanceTransformChannels Channels(this);
+
+	TArray<const TArray<float>*> SrcCustomDataChannels;
+	GetCustomDataChannels(InCustomDataChannels, SrcCustomDataChannels);
 
-		for (int n = 0; n < InstancedStaticMesh->NumCustomDataFloats && n < SrcCustomDataChannels.Num(); n++)
+	const bool bLayoutChanged = PrepareInstancedStaticMesh(InstancedStaticMesh, MultiSampleNum, InCustomDataChannels.Num(), bKeepInstancePhysics);
+
+	// With persistent channels only the runs of samples patched this frame are rebuilt,
+	// each sent as its own batch
+	TArray<FIntPoint> Runs;
+	const bool bFullUpdate = !bPersistentChannels || bLayoutChanged;
+
+	if (bFullUpdate)
+		Runs.Add(FIntPoint(0, MultiSampleNum));
+	else
+		GetMultiSampleDirtyRuns(Runs);
+
+	for (const FIntPoint& Run : Runs)
+	{
+		InstanceData.SetNum(Run.Y - Run.X);
+
+		float* CustomData = InstancedStaticMesh->PerInstanceSMCustomData.GetData() + Run.X * InstancedStaticMesh->NumCustomDataFloats;
+
+		for (int i = Run.X; i < Run.Y; i++)
 		{
-			*CustomData = SrcCustomDataChannels[n][i];
-			CustomData++;
+			InstanceData[i - Run.X].Transform = Channels.GetInstanceTransform(i);
+
+			for (int n = 0; n < InstancedStaticMesh->NumCustomDataFloats; n++)
+			{
+				if (n < SrcCustomDataChannels.Num())
+					*CustomData = (*SrcCustomDataChannels[n])[i];
+				CustomData++;
+			}
 		}
+
+		CommitInstancedStaticMesh(InstancedStaticMesh, Run.X, InstanceData, bKeepInstancePhysics, bFullUpdate);
 	}
+}
 
-	InstancedStaticMesh->BatchUpdateInstancesData(0, MultiSampleNum, InstanceData.GetData(), true);
+void UOSCActorComponent::UpdateInstancedStaticMeshes(const TArray<FOSCInstancedMeshTarget>& Targets, const FString& MeshIndexChannel)
+{
+	const TArray<float>& MeshIndices = GetOSCMultiSampleParam(MeshIndexChannel);
+
+	struct FTargetState
+	{
+		UInstancedStaticMeshComponent* Mesh = nullptr;
+		TArray<const TArray<float>*> CustomDataChannels;
+		TArray<FInstancedStaticMeshInstanceData> InstanceData;
+		float* CustomData = nullptr;
+		int Num = 0;
+	};
+
+	TArray<FTargetState> States;
+	States.SetNum(Targets.Num());
+
+	for (int t = 0; t < Targets.Num(); t++)
+	{
+		UInstancedStaticMeshComponent* Mesh = IsValid(Targets[t].InstancedStaticMesh) ? Targets[t].InstancedStaticMesh : nullptr;
+
+		// A second entry would resize and overwrite the instances of the first one
+		const bool bDuplicate = Mesh && States.ContainsByPredicate([Mesh](const FTargetState& S) { return S.Mesh == Mesh; });
+		if (bDuplicate)
+		{
+			if (!bDuplicateTargetsLogged)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("OSCActor: %s is listed more than once in UpdateInstancedStaticMeshes targets, only the first entry is used"), *Mesh->GetName());
+				bDuplicateTargetsLogged = true;
+			}
+			continue;
+		}
+
+		States[t].Mesh = Mesh;
+		GetCustomDataChannels(Targets[t].CustomDataChannels, States[t].CustomDataChannels);
+	}
+
+	// Bucket the samples, samples without a valid index are dropped
+	TArray<int32> Buckets;
+	Buckets.SetNumUninitialized(MultiSampleNum);
+	int32 Dropped = 0;
+
+	for (int i = 0; i < MultiSampleNum; i++)
+	{
+		const int32 t = MeshIndices.Num() > i ? FMath::RoundToInt(MeshIndices[i]) : INDEX_NONE;
+		Buckets[i] = (t >= 0 && t < States.Num() && States[t].Mesh) ? t : INDEX_NONE;
+
+		if (Buckets[i] != INDEX_NONE)
+			States[t].Num++;
+		else
+			Dropped++;
+	}
+
+	if (Dropped > 0 && !bDroppedSamplesLogged)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OSCActor: %s dropped %d of %d samples without a usable mesh index (%s has %d samples, %d targets)"),
+			*GetNameSafe(GetOwner()), Dropped, MultiSampleNum, *MeshIndexChannel, MeshIndices.Num(), Targets.Num());
+		bDroppedSamplesLogged = true;
+	}
+
+	for (int t = 0; t < States.Num(); t++)
+	{
+		FTargetState& State = States[t];
+		if (!State.Mesh)
+			continue;
+
+		PrepareInstancedStaticMesh(State.Mesh, State.Num, Targets[t].CustomDataChannels.Num(), bKeepInstancePhysics);
+
+		State.InstanceData.Reset(State.Num);
+		State.CustomData = State.Mesh->PerInstanceSMCustomData.GetData();
+	}
+
+	// One pass over the samples, each transform is computed once
+	const FInstanceTransformChannels Channels(this);
+
+	for (int i = 0; i < MultiSampleNum; i++)
+	{
+		if (Buckets[i] == INDEX_NONE)
+			continue;
+
+		FTargetState& State = States[Buckets[i]];
+		State.InstanceData.AddUninitialized_GetRef().Transform = Channels.GetInstanceTransform(i);
+
+		for (int n = 0; n < State.Mesh->NumCustomDataFloats; n++)
+		{
+			if (n < State.CustomDataChannels.Num())
+				*State.CustomData = (*State.CustomDataChannels[n])[i];
+			State.CustomData++;
+		}
+	}
+
+	for (FTargetState& State : States)
+	{
+		if (State.Mesh && State.Num > 0)
+			CommitInstancedStaticMesh(State.Mesh, 0, State.InstanceData, bKeepInstancePhysics, true);
+	}
 }
 
 // ===================================================================================
@@ -232,7 +611,17 @@ const TArray<float>& AOSCActor::GetOSCMultiSampleParam(const FString& Key)
 	return OSCActorComponent->GetOSCMultiSampleParam(Key);
 }
 
+int32 AOSCActor::GetOSCParamHistory(const FString& Key, TArray<float>& OutValues, TArray<double>& OutTimestamps) const
+{
+	return OSCActorComponent->GetOSCParamHistory(Key, OutValues, OutTimestamps);
+}
+
 void AOSCActor::UpdateInstancedStaticMesh(UInstancedStaticMeshComponent* InstancedStaticMesh, TArray<FString> InCustomDataChannels)
 {
 	OSCActorComponent->UpdateInstancedStaticMesh(InstancedStaticMesh, InCustomDataChannels);
 }
+
+void AOSCActor::UpdateInstancedStaticMeshes(const TArray<FOSCInstancedMeshTarget>& Targets, const FString& MeshIndexChannel)
+{
+	OSCActorComponent->UpdateInstancedStaticMeshes(Targets, MeshIndexChannel);
+}
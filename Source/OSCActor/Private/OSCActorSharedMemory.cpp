@@ -0,0 +1,355 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OSCActorSharedMemory.h"
+
+#include "HAL/PlatformTime.h"
+#include "OSCManager.h"
+
+using namespace OSCActorSharedMemory;
+
+static const double ATTACH_RETRY_INTERVAL = 1.0;
+static const double IDLE_REATTACH_INTERVAL = 2.0;
+
+// ===================================================================================
+
+struct FOSCPacketReader
+{
+	const uint8* Data;
+	int32 Size;
+	int32 Pos = 0;
+
+	FOSCPacketReader(const uint8* InData, int32 InSize) : Data(InData), Size(InSize) {}
+
+	bool HasBytes(int32 n) const { return Pos + n <= Size; }
+
+	bool ReadU32(uint32& Out)
+	{
+		if (!HasBytes(4))
+			return false;
+
+		Out = (uint32(Data[Pos]) << 24) | (uint32(Data[Pos + 1]) << 16) | (uint32(Data[Pos + 2]) << 8) | uint32(Data[Pos + 3]);
+		Pos += 4;
+		return true;
+	}
+
+	bool ReadU64(uint64& Out)
+	{
+		uint32 Hi, Lo;
+		if (!ReadU32(Hi) || !ReadU32(Lo))
+			return false;
+
+		Out = (uint64(Hi) << 32) | Lo;
+		return true;
+	}
+
+	bool ReadString(FString& Out)
+	{
+		const int32 Start = Pos;
+		while (Pos < Size && Data[Pos] != 0)
+			Pos++;
+
+		if (Pos >= Size)
+			return false;
+
+		Out = FString(Pos - Start, (const ANSICHAR*)(Data + Start));
+		Pos = Align(Pos + 1, 4);
+		return Pos <= Size;
+	}
+};
+
+static bool DecodeMessage(const uint8* Data, int32 Size, TArray<FOSCMessage>& OutMessages)
+{
+	FOSCPacketReader Reader(Data, Size);
+
+	FString Address;
+	if (!Reader.ReadString(Address))
+		return false;
+
+	FString TypeTags;
+	if (Reader.HasBytes(1) && !Reader.ReadString(TypeTags))
+		return false;
+
+	FOSCMessage Message;
+	Message.SetAddress(UOSCManager::ConvertStringToOSCAddress(Address));
+
+	for (int32 i = 1; i < TypeTags.Len(); i++)
+	{
+		switch (TypeTags[i])
+		{
+		case 'f':
+		{
+			uint32 Bits;
+			if (!Reader.ReadU32(Bits))
+				return false;
+
+			float Value;
+			FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+			UOSCManager::AddFloat(Message, Value);
+			break;
+		}
+		case 'd':
+		{
+			uint64 Bits;
+			if (!Reader.ReadU64(Bits))
+				return false;
+
+			double Value;
+			FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+			UOSCManager::AddFloat(Message, (float)Value);
+			break;
+		}
+		case 'i':
+		{
+			uint32 Value;
+			if (!Reader.ReadU32(Value))
+				return false;
+
+			UOSCManager::AddInt32(Message, (int32)Value);
+			break;
+		}
+		case 'h':
+		{
+			uint64 Value;
+			if (!Reader.ReadU64(Value))
+				return false;
+
+			UOSCManager::AddInt64(Message, (int64)Value);
+			break;
+		}
+		case 's':
+		case 'S':
+		{
+			FString Value;
+			if (!Reader.ReadString(Value))
+				return false;
+
+			UOSCManager::AddString(Message, Value);
+			break;
+		}
+		case 'T':
+			UOSCManager::AddBool(Message, true);
+			break;
+		case 'F':
+			UOSCManager::AddBool(Message, false);
+			break;
+		case 'b':
+		{
+			uint32 BlobSize;
+			if (!Reader.ReadU32(BlobSize) || !Reader.HasBytes(Align((int32)BlobSize, 4)))
+				return false;
+
+			Reader.Pos += Align((int32)BlobSize, 4);
+			break;
+		}
+		case 'N':
+		case 'I':
+			break;
+		default:
+			// Unknown argument size, the rest of the message can't be decoded.
+			OutMessages.Add(MoveTemp(Message));
+			return true;
+		}
+	}
+
+	OutMessages.Add(MoveTemp(Message));
+	return true;
+}
+
+static bool DecodeElement(const uint8* Data, int32 Size, TArray<FOSCMessage>& OutMessages, int32 Depth)
+{
+	static const uint8 BUNDLE_TAG[8] = { '#', 'b', 'u', 'n', 'd', 'l', 'e', 0 };
+
+	if (Size < 4 || Depth > 8)
+		return false;
+
+	if (Size < 16 || FMemory::Memcmp(Data, BUNDLE_TAG, sizeof(BUNDLE_TAG)) != 0)
+		return DecodeMessage(Data, Size, OutMessages);
+
+	FOSCPacketReader Reader(Data, Size);
+	Reader.Pos = 16; // "#bundle\0" + time tag
+
+	while (Reader.HasBytes(4))
+	{
+		uint32 ElementSize;
+		Reader.ReadU32(ElementSize);
+
+		if (!Reader.HasBytes((int32)ElementSize))
+			return false;
+
+		if (!DecodeElement(Data + Reader.Pos, (int32)ElementSize, OutMessages, Depth + 1))
+			return false;
+
+		Reader.Pos += (int32)ElementSize;
+	}
+
+	return true;
+}
+
+bool FOSCActorSharedMemoryReceiver::DecodePacket(const uint8* Data, int32 Size, TArray<FOSCMessage>& OutMessages, uint64* OutTimeTag)
+{
+	if (OutTimeTag)
+	{
+		*OutTimeTag = 0;
+
+		if (Size >= 16 && FMemory::Memcmp(Data, "#bundle", 8) == 0)
+		{
+			FOSCPacketReader Reader(Data, Size);
+			Reader.Pos = 8;
+			Reader.ReadU64(*OutTimeTag);
+		}
+	}
+
+	return DecodeElement(Data, Size, OutMessages, 0);
+}
+
+// ===================================================================================
+
+FOSCActorSharedMemoryReceiver::FOSCActorSharedMemoryReceiver(const FString& InName)
+	: Name(InName)
+{
+}
+
+FOSCActorSharedMemoryReceiver::~FOSCActorSharedMemoryReceiver()
+{
+	Detach();
+}
+
+const FHeader* FOSCActorSharedMemoryReceiver::GetHeader() const
+{
+	return (const FHeader*)Region->GetAddress();
+}
+
+const FSlotHeader* FOSCActorSharedMemoryReceiver::GetSlot(uint64 Index) const
+{
+	const uint8* Base = (const uint8*)Region->GetAddress() + sizeof(FHeader);
+	return (const FSlotHeader*)(Base + SlotStride(SlotSize) * (Index % SlotCount));
+}
+
+bool FOSCActorSharedMemoryReceiver::TryAttach()
+{
+	const double Now = FPlatformTime::Seconds();
+	if (LastAttachTime >= 0 && Now - LastAttachTime < ATTACH_RETRY_INTERVAL)
+		return false;
+
+	LastAttachTime = Now;
+
+	// Map the header first to learn the ring geometry, then remap the whole region.
+	FPlatformMemory::FSharedMemoryRegion* HeaderRegion = FPlatformMemory::MapNamedSharedMemoryRegion(
+		Name, false, FPlatformMemory::ESharedMemoryAccess::Read, sizeof(FHeader));
+	if (!HeaderRegion)
+		return false;
+
+	const FHeader Header = *(const FHeader*)HeaderRegion->GetAddress();
+	FPlatformMemory::UnmapNamedSharedMemoryRegion(HeaderRegion);
+
+	if (Header.Magic != Magic || Header.Version != Version || Header.SlotCount == 0 || Header.SlotSize == 0)
+		return false;
+
+	Region = FPlatformMemory::MapNamedSharedMemoryRegion(
+		Name, false, FPlatformMemory::ESharedMemoryAccess::Read, RegionSize(Header.SlotCount, Header.SlotSize));
+	if (!Region)
+		return false;
+
+	SlotCount = Header.SlotCount;
+	SlotSize = Header.SlotSize;
+
+	const uint64 Published = (uint64)FPlatformAtomics::AtomicRead((volatile const int64*)&GetHeader()->PublishedCount);
+	const uint64 RegionGeneration = GetHeader()->Generation;
+
+	// Reattaching to the same region (e.g. after the idle remap) continues where we left
+	// off. A new region starts from its newest packet; older ones are stale by now.
+	if (RegionGeneration == 0 || RegionGeneration != Generation || NextIndex > Published)
+		NextIndex = Published > 0 ? Published - 1 : 0;
+
+	Generation = RegionGeneration;
+	LastPacketTime = Now;
+
+	UE_LOG(LogTemp, Log, TEXT("OSCActor: attached to shared memory '%s' (%u slots x %u bytes)"), *Name, SlotCount, SlotSize);
+
+	return true;
+}
+
+void FOSCActorSharedMemoryReceiver::Detach()
+{
+	if (!Region)
+		return;
+
+	FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+	Region = nullptr;
+}
+
+int32 FOSCActorSharedMemoryReceiver::Poll(TFunctionRef<void(const TArray<FOSCMessage>&, uint64)> Callback)
+{
+	if (!Region && !TryAttach())
+		return 0;
+
+	const FHeader* Header = GetHeader();
+	const double Now = FPlatformTime::Seconds();
+
+	// The writer re-created the region (possibly with a different geometry).
+	if (FPlatformAtomics::AtomicRead((volatile const int32*)&Header->Magic) != (int32)Magic
+		|| Header->SlotCount != SlotCount || Header->SlotSize != SlotSize || Header->Generation != Generation)
+	{
+		Detach();
+		return 0;
+	}
+
+	const uint64 Published = (uint64)FPlatformAtomics::AtomicRead((volatile const int64*)&Header->PublishedCount);
+	FPlatformMisc::MemoryBarrier();
+
+	if (Published == NextIndex)
+	{
+		// A writer that restarted may have unlinked this region and created a new
+		// one under the same name; remap periodically while idle to pick it up.
+		if (Now - LastPacketTime > IDLE_REATTACH_INTERVAL)
+		{
+			Detach();
+			LastAttachTime = -1;
+		}
+		return 0;
+	}
+
+	if (Published < NextIndex)
+		NextIndex = 0;
+
+	// Packets older than the ring capacity have been overwritten.
+	if (Published - NextIndex > SlotCount)
+		NextIndex = Published - SlotCount;
+
+	int32 Delivered = 0;
+
+	for (uint64 Index = NextIndex; Index < Published; Index++)
+	{
+		const FSlotHeader* Slot = GetSlot(Index);
+		const uint64 Expected = (Index + 1) * 2;
+
+		const uint64 Begin = (uint64)FPlatformAtomics::AtomicRead((volatile const int64*)&Slot->Sequence);
+		if (Begin != Expected)
+			continue;
+
+		FPlatformMisc::MemoryBarrier();
+
+		const int32 Size = (int32)FMath::Min(Slot->Size, SlotSize);
+		Scratch.SetNumUninitialized(Size);
+		FMemory::Memcpy(Scratch.GetData(), Slot + 1, Size);
+
+		FPlatformMisc::MemoryBarrier();
+
+		const uint64 End = (uint64)FPlatformAtomics::AtomicRead((volatile const int64*)&Slot->Sequence);
+		if (End != Begin)
+			continue;
+
+		Messages.Reset();
+		uint64 TimeTag = 0;
+		if (DecodePacket(Scratch.GetData(), Size, Messages, &TimeTag))
+		{
+			Callback(Messages, TimeTag);
+			Delivered++;
+		}
+	}
+
+	NextIndex = Published;
+	LastPacketTime = Now;
+
+	return Delivered;
+}
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformMemory.h"
+#include "OSCMessage.h"
+
+// Shared-memory ring buffer layout.
+// Must stay in sync with Extras/OSCSharedMemoryWriter/OSCSharedMemoryWriter.h
+
+namespace OSCActorSharedMemory
+{
+	static constexpr uint32 Magic = 0x5343534F; // 'OSCS'
+	static constexpr uint32 Version = 1;
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 SlotCount;
+		uint32 SlotSize;
+		uint64 PublishedCount;
+		uint64 Generation; // non-zero, new every time the writer creates the region
+		uint8 Padding[32];
+	};
+	static_assert(sizeof(FHeader) == 64, "FHeader must be 64 bytes");
+
+	struct FSlotHeader
+	{
+		// Odd while being written, 2 * (PacketIndex + 1) once published.
+		uint64 Sequence;
+		uint32 Size;
+		uint32 Reserved;
+	};
+	static_assert(sizeof(FSlotHeader) == 16, "FSlotHeader must be 16 bytes");
+
+	inline SIZE_T SlotStride(uint32 SlotSize)
+	{
+		return Align(sizeof(FSlotHeader) + SlotSize, 64);
+	}
+
+	inline SIZE_T RegionSize(uint32 SlotCount, uint32 SlotSize)
+	{
+		return sizeof(FHeader) + SlotStride(SlotSize) * SlotCount;
+	}
+}
+
+// ===================================================================================
+
+// Reads OSC packets published by a same-machine sender into a named shared-memory
+// ring buffer, as an alternative to the UDP listener.
+class FOSCActorSharedMemoryReceiver
+{
+public:
+
+	explicit FOSCActorSharedMemoryReceiver(const FString& InName);
+	~FOSCActorSharedMemoryReceiver();
+
+	// Decodes every packet published since the last call and passes its messages and
+	// bundle time tag (0 for a bare message) to Callback, one call per packet.
+	// Returns the number of packets delivered.
+	int32 Poll(TFunctionRef<void(const TArray<FOSCMessage>&, uint64)> Callback);
+
+	bool IsAttached() const { return Region != nullptr; }
+
+	// Decodes a raw OSC packet (message or bundle) into its messages.
+	static bool DecodePacket(const uint8* Data, int32 Size, TArray<FOSCMessage>& OutMessages, uint64* OutTimeTag = nullptr);
+
+private:
+
+	bool TryAttach();
+	void Detach();
+
+	const OSCActorSharedMemory::FHeader* GetHeader() const;
+	const OSCActorSharedMemory::FSlotHeader* GetSlot(uint64 Index) const;
+
+	FString Name;
+	FPlatformMemory::FSharedMemoryRegion* Region = nullptr;
+	uint32 SlotCount = 0;
+	uint32 SlotSize = 0;
+	uint64 NextIndex = 0;
+
+	// Region NextIndex refers to, 0 before the first attach
+	uint64 Generation = 0;
+
+	double LastAttachTime = -1;
+	double LastPacketTime = 0;
+
+	TArray<uint8> Scratch;
+	TArray<FOSCMessage> Messages;
+};
@@ -5,76 +5,761 @@
 #endif
 #include "OSCActor.h"
 #include "OSCActorModule.h"
+#include "OSCActorSharedMemory.h"
 #include "OSCCineCameraActor.h"
+#include "OSCEntityRendererComponent.h"
+#include "OSCClient.h"
 #include "OSCManager.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Objects Updated"), STAT_OSCActorUpdated, STATGROUP_OSCActor);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Objects Deferred"), STAT_OSCActorDeferred, STATGROUP_OSCActor);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Updates Skipped"), STAT_OSCActorSkipped, STATGROUP_OSCActor);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Updates Forced"), STAT_OSCActorForced, STATGROUP_OSCActor);
+DECLARE_CYCLE_STAT(TEXT("Object Updates"), STAT_OSCActorObjectUpdates, STATGROUP_OSCActor);
+
+// Below this many objects in a batch the task dispatch costs more than it saves.
+static const int32 PARALLEL_APPLY_MIN_OBJECTS = 4;
+
+// ss / ms / msp messages only touch the target component's own parameter maps,
+// so they are grouped per object and applied off the game thread.
+enum class EOSCSampleMessageType : uint8
+{
+	SingleSample,
+	MultiSample,
+	MultiSamplePatch,
+};
+
+struct FOSCSampleMessage
+{
+	const FOSCMessage* Message;
+	FString ParName;
+	EOSCSampleMessageType Type;
+};
+
+struct FOSCObjectSampleMessages
+{
+	UOSCActorComponent* Component;
+	TArray<FOSCSampleMessage> Messages;
+};
 
 UOSCActorSettings::UOSCActorSettings(const class FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {}
 
+#if WITH_EDITOR
+void UOSCActorSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Only the endpoints need the listener / sender rebuilt, the rest is read every frame
+	static const FName ENDPOINT_PROPERTIES[] = {
+		GET_MEMBER_NAME_CHECKED(UOSCActorSettings, OSCAddress),
+		GET_MEMBER_NAME_CHECKED(UOSCActorSettings, OSCReceivePort),
+		GET_MEMBER_NAME_CHECKED(UOSCActorSettings, bUseSharedMemory),
+		GET_MEMBER_NAME_CHECKED(UOSCActorSettings, SharedMemoryName),
+		GET_MEMBER_NAME_CHECKED(UOSCActorSettings, bSendFrameAck),
+		GET_MEMBER_NAME_CHECKED(UOSCActorSettings, FrameAckAddress),
+		GET_MEMBER_NAME_CHECKED(UOSCActorSettings, FrameAckPort),
+	};
+
+	bool bEndpointChanged = false;
+	for (const FName& Name : ENDPOINT_PROPERTIES)
+		bEndpointChanged |= PropertyChangedEvent.GetMemberPropertyName() == Name;
+
+	if (!bEndpointChanged)
+		return;
+
+	// Rebind the listener without restarting the editor
+	UOSCActorSubsystem* S = GEngine ? GEngine->GetEngineSubsystem<UOSCActorSubsystem>() : nullptr;
+	if (S)
+		S->ApplySettings();
+}
+#endif
+
 void UOSCActorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
-	const UOSCActorSettings* Settings = GetDefault <UOSCActorSettings>();
-	
-	OSCServer = NewObject<UOSCServer>(this, FName("OSCActorServer"));
-	OSCServer->SetAddress(Settings->OSCAddress, Settings->OSCReceivePort);
+	// The listener is started lazily by the first registered component,
+	// so commandlets and sessions without OSC content never bind the port.
+}
+
+void UOSCActorSubsystem::Deinitialize()
+{
+	StopListening();
+
+	if (OSCServer)
+	{
+		OSCServer->OnOscBundleReceived.RemoveDynamic(this, &UOSCActorSubsystem::OnOscBundleReceived);
+		OSCServer->ConditionalBeginDestroy();
+		OSCServer = nullptr;
+	}
+
+	Super::Deinitialize();
+}
+
+void UOSCActorSubsystem::StartListening()
+{
+	const UOSCActorSettings* Settings = GetDefault<UOSCActorSettings>();
+
+	if (!OSCServer)
+	{
+		OSCServer = NewObject<UOSCServer>(this, FName("OSCActorServer"));
 #if WITH_EDITOR
-	OSCServer->SetTickInEditor(true);
+		OSCServer->SetTickInEditor(true);
 #endif
+		OSCServer->OnOscBundleReceived.AddDynamic(this, &UOSCActorSubsystem::OnOscBundleReceived);
+	}
+
+	OSCServer->SetAddress(Settings->OSCAddress, Settings->OSCReceivePort);
 	OSCServer->Listen();
-	
-	OSCServer->OnOscBundleReceived.AddDynamic(this, &UOSCActorSubsystem::OnOscBundleReceived);
+
+	if (Settings->bSendFrameAck)
+	{
+		FrameAckClient = UOSCManager::CreateOSCClient(Settings->FrameAckAddress, Settings->FrameAckPort, TEXT("OSCActorFrameAck"), this);
+	}
+
+	if (Settings->bUseSharedMemory && !Settings->SharedMemoryName.IsEmpty())
+	{
+		SharedMemoryReceiver = MakeShared<FOSCActorSharedMemoryReceiver>(Settings->SharedMemoryName);
+	}
+
+	// Polls shared memory and drains updates deferred by the scheduler
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UOSCActorSubsystem::Tick));
+
+	bListening = true;
 }
 
-void UOSCActorSubsystem::Deinitialize()
+void UOSCActorSubsystem::StopListening()
 {
-	OSCServer->OnOscBundleReceived.RemoveDynamic(this, &UOSCActorSubsystem::OnOscBundleReceived);
+	if (TickHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+		TickHandle.Reset();
+	}
+	SharedMemoryReceiver.Reset();
 
-	OSCServer->Stop();
-	OSCServer->ConditionalBeginDestroy();
+	if (OSCServer)
+		OSCServer->Stop();
 
-	Super::Deinitialize();
+	if (FrameAckClient)
+	{
+		FrameAckClient->ConditionalBeginDestroy();
+		FrameAckClient = nullptr;
+	}
+
+	bListening = false;
+}
+
+void UOSCActorSubsystem::ApplySettings()
+{
+	// Registered components are kept, only the endpoint is rebound
+	if (bListening)
+	{
+		StopListening();
+		StartListening();
+	}
 }
 
 void UOSCActorSubsystem::UpdateActorReference(UActorComponent* Component_)
 {
 	if (UOSCActorComponent* Actor = Cast<UOSCActorComponent>(Component_))
 	{
-		OSCActorComponentMap.Add(Actor->ObjectName, Actor);
+		UOSCActorComponent** Existing = OSCActorComponentMap.Find(Actor->ObjectName);
+		if (!Existing || *Existing != Actor)
+		{
+			// ObjectName changed, drop the entry under the old name
+			RemoveActorReferences(Actor);
+
+			OSCActorComponentMap.Add(Actor->ObjectName, Actor);
+
+			// An actor with the same name takes over from the lightweight entity
+			SetEntityPromoted(Actor->ObjectName, true);
+		}
 	}
 	else if (UOSCCineCameraComponent* Camera = Cast<UOSCCineCameraComponent>(Component_))
 	{
-		OSCCameraComponentMap.Add(Camera->ObjectName, Camera);
+		UOSCCineCameraComponent** Existing = OSCCameraComponentMap.Find(Camera->ObjectName);
+		if (!Existing || *Existing != Camera)
+		{
+			OSCCameraComponentMap = OSCCameraComponentMap.FilterByPredicate([Camera](const auto& It) { return It.Value != Camera; });
+			OSCCameraComponentMap.Add(Camera->ObjectName, Camera);
+		}
+	}
+	else if (UOSCEntityRendererComponent* Renderer = Cast<UOSCEntityRendererComponent>(Component_))
+	{
+		if (!EntityRenderers.Contains(Renderer))
+			EntityRenderers.Add(Renderer);
 	}
+	else
+	{
+		return;
+	}
+
+	if (!bListening)
+		StartListening();
 }
 
 void UOSCActorSubsystem::RemoveActorReference(UActorComponent* Component_)
 {
 	if (UOSCActorComponent* Actor = Cast<UOSCActorComponent>(Component_))
 	{
-		OSCActorComponentMap.Remove(Actor->ObjectName);
+		RemoveActorReferences(Actor);
 	}
 	else if (UOSCCineCameraComponent* Camera = Cast<UOSCCineCameraComponent>(Component_))
 	{
-		OSCCameraComponentMap.Remove(Camera->ObjectName);
+		OSCCameraComponentMap = OSCCameraComponentMap.FilterByPredicate([Camera](const auto& It) { return It.Value != Camera; });
+	}
+	else if (UOSCEntityRendererComponent* Renderer = Cast<UOSCEntityRendererComponent>(Component_))
+	{
+		const int32 RendererIndex = EntityRenderers.IndexOfByKey(Renderer);
+		if (RendererIndex != INDEX_NONE)
+			RemoveEntityRenderer(RendererIndex);
+	}
+
+	PruneReferences();
+
+	if (bListening && OSCActorComponentMap.Num() == 0 && OSCCameraComponentMap.Num() == 0 && EntityRenderers.Num() == 0)
+		StopListening();
+}
+
+void UOSCActorSubsystem::RemoveActorReferences(UOSCActorComponent* Actor)
+{
+	// Any name the component was registered under, it may have been renamed since
+	for (auto It = OSCActorComponentMap.CreateIterator(); It; ++It)
+	{
+		if (It.Value() == Actor)
+		{
+			SetEntityPromoted(It.Key(), false);
+			It.RemoveCurrent();
+		}
+	}
+
+	PendingUpdates.RemoveSwap(Actor);
+}
+
+void UOSCActorSubsystem::PruneReferences()
+{
+	for (auto It = OSCActorComponentMap.CreateIterator(); It; ++It)
+	{
+		if (!IsValid(It.Value()))
+		{
+			PendingUpdates.RemoveSwap(It.Value());
+			SetEntityPromoted(It.Key(), false);
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = OSCCameraComponentMap.CreateIterator(); It; ++It)
+	{
+		if (!IsValid(It.Value()))
+			It.RemoveCurrent();
+	}
+
+	for (int32 i = EntityRenderers.Num() - 1; i >= 0; i--)
+	{
+		if (!IsValid(EntityRenderers[i]))
+			RemoveEntityRenderer(i);
+	}
+}
+
+void UOSCActorSubsystem::SetEntityPromoted(const FString& Name, bool bPromoted)
+{
+	const int32 Entity = EntityTable.Find(Name);
+	if (Entity == INDEX_NONE || EntityTable.Promoted[Entity] == bPromoted)
+		return;
+
+	EntityTable.Promoted[Entity] = bPromoted;
+
+	// The actor received the messages meanwhile, restart the timeout
+	if (!bPromoted)
+		EntityTable.LastSeenTimes[Entity] = FPlatformTime::Seconds();
+
+	UOSCEntityRendererComponent* Renderer = EntityRenderers[EntityTable.Renderers[Entity]];
+	if (IsValid(Renderer))
+		Renderer->MarkSlotDirty(EntityTable.Slots[Entity]);
+}
+
+void UOSCActorSubsystem::ProcessEntityMessage(const FString& Name, const TArray<FString>& Comp, const FOSCMessage& Message)
+{
+	static const FMatrix ROT_YAW_90 = FRotationMatrix::Make(FRotator(0, 90, 0));
+
+	int32 Entity = EntityTable.Find(Name);
+
+	if (Entity == INDEX_NONE)
+	{
+		// New names become entities of the first renderer claiming their prefix
+		const int32 RendererIndex = EntityRenderers.IndexOfByPredicate([&Name](const UOSCEntityRendererComponent* R)
+		{
+			return IsValid(R) && !R->NamePrefix.IsEmpty() && Name.StartsWith(R->NamePrefix);
+		});
+
+		if (RendererIndex == INDEX_NONE)
+			return;
+
+		UOSCEntityRendererComponent* Renderer = EntityRenderers[RendererIndex];
+		Entity = EntityTable.Add(Name, RendererIndex, Renderer->Members.Num());
+		Renderer->Members.Add(Entity);
+		Renderer->MarkSlotDirty(EntityTable.Slots[Entity]);
+	}
+
+	UOSCEntityRendererComponent* Renderer = EntityRenderers[EntityTable.Renderers[Entity]];
+	if (!IsValid(Renderer) || Comp.Num() < 3)
+		return;
+
+	const FString& Type = Comp[2];
+
+	if (Type == "active")
+	{
+		bool Value = false;
+		UOSCManager::GetBool(Message, 0, Value);
+
+		EntityTable.Visible[Entity] = Value;
+	}
+	else if (Type == "TRS")
+	{
+		TArray<float> OutValues;
+		UOSCManager::GetAllFloats(Message, OutValues);
+		if (OutValues.Num() < 9)
+			return;
+
+		const float* a = OutValues.GetData();
+		FMatrix M = UOSCActorFunctionLibrary::TRSToMatrix(
+			a[0], a[1], a[2],
+			a[3], a[4], a[5],
+			a[6], a[7], a[8]
+		);
+
+		M = UOSCActorFunctionLibrary::ConvertGLtoUE4Matrix(M);
+		M = ROT_YAW_90 * M;
+
+		EntityTable.Transforms[Entity] = FTransform(M);
+	}
+	else if (Type == "ss" && Comp.Num() > 3)
+	{
+		TArray<float> OutValues;
+		UOSCManager::GetAllFloats(Message, OutValues);
+		if (OutValues.Num() == 0)
+			return;
+
+		// Entity params persist across frame_number like the rest of the record
+		EntityTable.SetParam(Entity, EntityTable.GetParamColumn(Comp[3], true), OutValues.Last());
+	}
+	else
+	{
+		return;
+	}
+
+	// Any message keeps the record alive, inactive entities are only hidden
+	EntityTable.LastSeenTimes[Entity] = FPlatformTime::Seconds();
+
+	Renderer->MarkSlotDirty(EntityTable.Slots[Entity]);
+}
+
+void UOSCActorSubsystem::RemoveEntityAt(int32 Entity)
+{
+	UOSCEntityRendererComponent* Renderer = EntityRenderers[EntityTable.Renderers[Entity]];
+	if (IsValid(Renderer))
+		Renderer->RemoveSlot(EntityTable.Slots[Entity], EntityTable);
+
+	// The last record takes over the index, point its instance slot at it
+	if (EntityTable.RemoveAtSwap(Entity) != INDEX_NONE)
+	{
+		UOSCEntityRendererComponent* MovedRenderer = EntityRenderers[EntityTable.Renderers[Entity]];
+		if (IsValid(MovedRenderer))
+			MovedRenderer->Members[EntityTable.Slots[Entity]] = Entity;
+	}
+}
+
+void UOSCActorSubsystem::RemoveEntityRenderer(int32 RendererIndex)
+{
+	// Backwards, so the record swapped into a removed index has already been checked
+	for (int32 Entity = EntityTable.Num() - 1; Entity >= 0; Entity--)
+	{
+		if (EntityTable.Renderers[Entity] == RendererIndex)
+			RemoveEntityAt(Entity);
+	}
+
+	UOSCEntityRendererComponent* Renderer = EntityRenderers[RendererIndex];
+	if (IsValid(Renderer))
+		Renderer->ResetMembers();
+
+	// Entity records refer to renderers by index
+	EntityRenderers.RemoveAt(RendererIndex);
+
+	for (int32& Index : EntityTable.Renderers)
+	{
+		if (Index > RendererIndex)
+			Index--;
+	}
+}
+
+bool UOSCActorSubsystem::RemoveEntity(const FString& Name)
+{
+	const int32 Entity = EntityTable.Find(Name);
+	if (Entity == INDEX_NONE)
+		return false;
+
+	RemoveEntityAt(Entity);
+	return true;
+}
+
+void UOSCActorSubsystem::EvictEntities()
+{
+	const float Timeout = GetDefault<UOSCActorSettings>()->EntityTimeout;
+	if (Timeout <= 0 || EntityTable.Num() == 0)
+		return;
+
+	const double Oldest = FPlatformTime::Seconds() - Timeout;
+
+	// Backwards, so the record swapped into a removed index has already been checked
+	for (int32 Entity = EntityTable.Num() - 1; Entity >= 0; Entity--)
+	{
+		if (!EntityTable.Promoted[Entity] && EntityTable.LastSeenTimes[Entity] < Oldest)
+			RemoveEntityAt(Entity);
+	}
+}
+
+void UOSCActorSubsystem::SyncEntityRenderers()
+{
+	for (UOSCEntityRendererComponent* Renderer : EntityRenderers)
+	{
+		if (IsValid(Renderer))
+			Renderer->SyncInstances(EntityTable);
+	}
+}
+
+AActor* UOSCActorSubsystem::PromoteEntity(UObject* WorldContextObject, const FString& Name, TSubclassOf<AActor> ActorClass)
+{
+	const int32 Entity = EntityTable.Find(Name);
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (Entity == INDEX_NONE || !World || !ActorClass)
+		return nullptr;
+
+	UOSCEntityRendererComponent* Renderer = EntityRenderers[EntityTable.Renderers[Entity]];
+	if (!IsValid(Renderer))
+		return nullptr;
+
+	// Entity transforms are relative to the renderer, like TRS on attached actors
+	const FTransform& RelativeTransform = EntityTable.Transforms[Entity];
+
+	AActor* Actor = World->SpawnActor<AActor>(ActorClass, RelativeTransform * Renderer->GetComponentTransform());
+	if (!Actor)
+		return nullptr;
+
+	UOSCActorComponent* Component = Actor->FindComponentByClass<UOSCActorComponent>();
+	if (!Component)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OSCActor: %s has no OSCActorComponent, can't promote entity %s"), *ActorClass->GetName(), *Name);
+		Actor->Destroy();
+		return nullptr;
+	}
+
+	Actor->AttachToComponent(Renderer, FAttachmentTransformRules::KeepWorldTransform);
+
+	Component->ObjectName = Name;
+	EntityTable.GetParams(Entity, Component->Params);
+
+	UpdateActorReference(Component);
+
+	return Actor;
+}
+
+bool UOSCActorSubsystem::GetEntityTransform(const FString& Name, FTransform& OutTransform) const
+{
+	const int32 Entity = EntityTable.Find(Name);
+	if (Entity == INDEX_NONE)
+		return false;
+
+	OutTransform = EntityTable.Transforms[Entity];
+	return true;
+}
+
+float UOSCActorSubsystem::GetEntityParam(const FString& Name, const FString& Key, float DefaultValue) const
+{
+	const int32 Entity = EntityTable.Find(Name);
+	if (Entity == INDEX_NONE)
+		return DefaultValue;
+
+	return EntityTable.GetParam(Entity, Key, DefaultValue);
+}
+
+bool UOSCActorSubsystem::Tick(float DeltaTime)
+{
+	if (SharedMemoryReceiver)
+	{
+		SharedMemoryReceiver->Poll([this](const TArray<FOSCMessage>& Messages, uint64 TimeTag)
+		{
+			ProcessMessages(Messages, TimeTag);
+		});
+	}
+
+	// Runs even when no packets arrive, a sender that stopped still gets its entities evicted
+	EvictEntities();
+	SyncEntityRenderers();
+
+	RunScheduledUpdates();
+
+	return true;
+}
+
+void UOSCActorSubsystem::RequestUpdate(UOSCActorComponent* Component)
+{
+	if (Component->bPendingUpdate)
+	{
+		// The deferred update will run with the newest data instead
+		CurrentSchedulerStats.Skipped++;
+		INC_DWORD_STAT(STAT_OSCActorSkipped);
+		return;
+	}
+
+	Component->bPendingUpdate = true;
+	PendingUpdates.Add(Component);
+}
+
+void UOSCActorSubsystem::RunUpdate(UOSCActorComponent* Component, double Now)
+{
+	Component->bPendingUpdate = false;
+	Component->FramesWaiting = 0;
+	Component->LastUpdateTime = Now;
+
+	Component->ApplyMaterialBindings();
+	Component->ApplyPropertyBindings();
+
+	if (Component->UpdateFromOSC.IsBound())
+	{
+		FEditorScriptExecutionGuard ScriptGuard;
+		Component->UpdateFromOSC.Broadcast();
+	}
+}
+
+void UOSCActorSubsystem::RunScheduledUpdates()
+{
+	SCOPE_CYCLE_COUNTER(STAT_OSCActorObjectUpdates);
+
+	// The budget and counters are per engine frame, bundles received in the same frame share them
+	if (SchedulerFrame != GFrameCounter)
+	{
+		SchedulerStats = CurrentSchedulerStats;
+		CurrentSchedulerStats = FOSCActorSchedulerStats();
+		SchedulerFrame = GFrameCounter;
+		SchedulerSpentMs = 0;
+
+		// Deferred updates age once per engine frame, however many bundles that frame had
+		for (UOSCActorComponent* Component : PendingUpdates)
+		{
+			if (IsValid(Component))
+				Component->FramesWaiting++;
+		}
+	}
+
+	if (PendingUpdates.Num() == 0)
+		return;
+
+	const UOSCActorSettings* Settings = GetDefault<UOSCActorSettings>();
+	const double Now = FPlatformTime::Seconds();
+	const double StartTime = Now;
+
+	TArray<UOSCActorComponent*> Updates = MoveTemp(PendingUpdates);
+	PendingUpdates.Reset();
+
+	if (Settings->UpdateBudgetMs <= 0)
+	{
+		// No budget, update everything in arrival order
+		for (UOSCActorComponent* Component : Updates)
+		{
+			if (IsValid(Component))
+				RunUpdate(Component, Now);
+		}
+
+		CurrentSchedulerStats.Updated += Updates.Num();
+		INC_DWORD_STAT_BY(STAT_OSCActorUpdated, Updates.Num());
+	}
+	else
+	{
+		struct FScheduledUpdate
+		{
+			UOSCActorComponent* Component;
+			bool bOverdue;
+			float Score;
+		};
+
+		TArray<FScheduledUpdate> Schedule;
+		Schedule.Reserve(Updates.Num());
+
+		for (UOSCActorComponent* Component : Updates)
+		{
+			if (!IsValid(Component))
+				continue;
+
+			const AActor* Owner = Component->GetOwner();
+			const bool bRendered = !Component->bDeprioritizeWhenNotRendered || !Owner || Owner->WasRecentlyRendered(0.5f);
+			const bool bOverdue = Component->MinUpdateRate > 0 && Now - Component->LastUpdateTime >= 1.0 / Component->MinUpdateRate;
+
+			// Waiting raises the score so low priority objects are not starved
+			float Score = Component->UpdatePriority * (bRendered ? 1.0f : Settings->NotRenderedPriorityScale);
+			Score *= 1 + Component->FramesWaiting;
+
+			Schedule.Add({ Component, bOverdue, Score });
+		}
+
+		Schedule.Sort([](const FScheduledUpdate& A, const FScheduledUpdate& B)
+		{
+			if (A.bOverdue != B.bOverdue)
+				return A.bOverdue;
+			return A.Score > B.Score;
+		});
+
+		for (const FScheduledUpdate& Update : Schedule)
+		{
+			if (!Update.bOverdue && SchedulerSpentMs >= Settings->UpdateBudgetMs)
+			{
+				PendingUpdates.Add(Update.Component);
+				continue;
+			}
+
+			const double UpdateStart = FPlatformTime::Seconds();
+			RunUpdate(Update.Component, UpdateStart);
+			SchedulerSpentMs += (FPlatformTime::Seconds() - UpdateStart) * 1000.0;
+
+			CurrentSchedulerStats.Updated++;
+			INC_DWORD_STAT(STAT_OSCActorUpdated);
+
+			if (Update.bOverdue && SchedulerSpentMs > Settings->UpdateBudgetMs)
+			{
+				CurrentSchedulerStats.Forced++;
+				INC_DWORD_STAT(STAT_OSCActorForced);
+			}
+		}
 	}
+
+	CurrentSchedulerStats.Deferred = PendingUpdates.Num();
+	CurrentSchedulerStats.UpdateTimeMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	SET_DWORD_STAT(STAT_OSCActorDeferred, PendingUpdates.Num());
 }
 
 void UOSCActorSubsystem::OnOscBundleReceived(const FOSCBundle& Bundle, const FString& IPAddress, int32 Port)
+{
+	auto Messages = UOSCManager::GetMessagesFromBundle(Bundle);
+
+	ProcessMessages(Messages);
+}
+
+// OSC time tags count NTP seconds since 1900 in 32.32 fixed point, 1 means "immediately"
+static double OSCTimeTagToPlatformSeconds(uint64 TimeTag)
+{
+	static const FDateTime NTP_EPOCH(1900, 1, 1);
+
+	const double TagSeconds = double(TimeTag >> 32) + double(TimeTag & 0xFFFFFFFF) / 4294967296.0;
+	const double NowSeconds = (FDateTime::UtcNow() - NTP_EPOCH).GetTotalSeconds();
+
+	return FPlatformTime::Seconds() - (NowSeconds - TagSeconds);
+}
+
+void UOSCActorSubsystem::ProcessMessages(const TArray<FOSCMessage>& Messages, uint64 TimeTag)
 {
 	static const FMatrix ROT_YAW_90 = FRotationMatrix::Make(FRotator(0, 90, 0));
 	
 	const UOSCActorSettings* Settings = GetDefault<UOSCActorSettings>();
-	
-	auto Messages = UOSCManager::GetMessagesFromBundle(Bundle);
 
 	TArray<FString> Keys;
 	OSCActorComponentMap.GetKeys(Keys);
+
+	bool bFrameCompleted = false;
+
+	TArray<FOSCObjectSampleMessages> PendingSamples;
+	TMap<UOSCActorComponent*, int32> PendingSampleIndices;
+
+	auto QueueSampleMessage = [&](UOSCActorComponent* Component, const FOSCMessage& Message, FString&& ParName, EOSCSampleMessageType Type)
+	{
+		int32& Index = PendingSampleIndices.FindOrAdd(Component, INDEX_NONE);
+		if (Index == INDEX_NONE)
+		{
+			Index = PendingSamples.Num();
+			PendingSamples.Add({ Component });
+		}
+
+		PendingSamples[Index].Messages.Add({ &Message, MoveTemp(ParName), Type });
+	};
+
+	// The sender's time tag when the bundle has one, else the dispatch time of this packet
+	const double Timestamp = TimeTag > 1 ? OSCTimeTagToPlatformSeconds(TimeTag) : FPlatformTime::Seconds();
+
+	auto FlushSampleMessages = [&]()
+	{
+		ParallelFor(PendingSamples.Num(), [&PendingSamples, Timestamp](int32 Index)
+		{
+			const FOSCObjectSampleMessages& Pending = PendingSamples[Index];
+			UOSCActorComponent* Component = Pending.Component;
+
+			for (const FOSCSampleMessage& Sample : Pending.Messages)
+			{
+				if (Sample.Type == EOSCSampleMessageType::MultiSample)
+				{
+					FChannelData Data;
+					UOSCManager::GetAllFloats(*Sample.Message, Data.Samples);
+					Data.MarkAllDirty();
+
+					Component->MultiSampleParams.Add(Sample.ParName, MoveTemp(Data));
+				}
+				else if (Sample.Type == EOSCSampleMessageType::MultiSamplePatch)
+				{
+					// Sparse update: int32 sample count, then (int32 index, float value) pairs
+					TArray<int32> Indices;
+					UOSCManager::GetAllInt32s(*Sample.Message, Indices);
+
+					TArray<float> Values;
+					UOSCManager::GetAllFloats(*Sample.Message, Values);
+
+					if (Indices.Num() == 0 || Indices[0] < 0)
+						continue;
+
+					FChannelData& Data = Component->MultiSampleParams.FindOrAdd(Sample.ParName);
+
+					const int32 Num = Indices[0];
+					if (Data.Samples.Num() != Num)
+						Data.Resize(Num);
+
+					float* Dst = Data.Samples.GetData();
+					const int32 PairNum = FMath::Min(Indices.Num() - 1, Values.Num());
+
+					for (int32 i = 0; i < PairNum; i++)
+					{
+						const int32 SampleIndex = Indices[i + 1];
+						if (SampleIndex < 0 || SampleIndex >= Num)
+							continue;
+
+						Dst[SampleIndex] = Values[i];
+						Data.MarkDirty(SampleIndex, SampleIndex + 1);
+					}
+				}
+				else
+				{
+					TArray<float> OutValues;
+					UOSCManager::GetAllFloats(*Sample.Message, OutValues);
+
+					if (OutValues.Num() > 0)
+						Component->Params.Add(Sample.ParName, OutValues.Last());
+
+					if (Component->bRecordParamHistory)
+					{
+						FParamHistory& History = Component->ParamHistory.FindOrAdd(Sample.ParName);
+						for (float Value : OutValues)
+							History.Add(Value, Timestamp, Component->ParamHistoryCapacity);
+					}
+				}
+			}
+		}, PendingSamples.Num() < PARALLEL_APPLY_MIN_OBJECTS ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+		PendingSamples.Reset();
+		PendingSampleIndices.Reset();
+	};
 		
-	for (auto Message : Messages)
+	for (const FOSCMessage& Message : Messages)
 	{
+		FrameMessageCount++;
+
 		auto Address = Message.GetAddress().GetFullPath();
 
 		TArray<FString> Comp;
@@ -86,7 +771,11 @@ void UOSCActorSubsystem::OnOscBundleReceived(const FOSCBundle& Bundle, const FSt
 			{
 				auto It = OSCActorComponentMap.Find(Name);
 				if (!It)
+				{
+					if (EntityRenderers.Num() > 0)
+						ProcessEntityMessage(Name, Comp, Message);
 					continue;
+				}
 
 				UOSCActorComponent* Component = *It;
 				if (!IsValid(Component))
@@ -127,23 +816,15 @@ void UOSCActorSubsystem::OnOscBundleReceived(const FOSCBundle& Bundle, const FSt
 				}
 				else if (Type == "ss")
 				{
-					auto ParName = Comp[3];
-
-					TArray<float> OutValues;
-					UOSCManager::GetAllFloats(Message, OutValues);
-
-					float v = OutValues.Last();
-					
-					Component->Params.Add(ParName, v);
+					QueueSampleMessage(Component, Message, MoveTemp(Comp[3]), EOSCSampleMessageType::SingleSample);
 				}
 				else if (Type == "ms")
 				{
-					auto ParName = Comp[3];
-
-					FChannelData Data;
-					UOSCManager::GetAllFloats(Message, Data.Samples);
-
-					Component->MultiSampleParams.Add(ParName, Data);
+					QueueSampleMessage(Component, Message, MoveTemp(Comp[3]), EOSCSampleMessageType::MultiSample);
+				}
+				else if (Type == "msp")
+				{
+					QueueSampleMessage(Component, Message, MoveTemp(Comp[3]), EOSCSampleMessageType::MultiSamplePatch);
 				}
 			}
 			else if (Comp[0] == "cam")
@@ -229,6 +910,9 @@ void UOSCActorSubsystem::OnOscBundleReceived(const FOSCBundle& Bundle, const FSt
 
 				if (Type == "frame_number")
 				{
+					// Samples queued before the frame marker belong to the previous frame
+					FlushSampleMessages();
+
 					// Clear actor cached data at start of frame.
 					for (auto Key : Keys)
 					{
@@ -239,6 +923,18 @@ void UOSCActorSubsystem::OnOscBundleReceived(const FOSCBundle& Bundle, const FSt
 							continue;
 						}
 
+						if (A->bPersistentChannels)
+						{
+							// Values survive across frames, only the change tracking restarts.
+							// A deferred update keeps accumulating its dirty ranges until it runs.
+							if (!A->bPendingUpdate)
+							{
+								for (auto& It : A->MultiSampleParams)
+									It.Value.ClearDirty();
+							}
+							continue;
+						}
+
 						A->Params.Reset();
 						A->MultiSampleParams.Reset();
 					}
@@ -246,11 +942,27 @@ void UOSCActorSubsystem::OnOscBundleReceived(const FOSCBundle& Bundle, const FSt
 					int Value;
 					UOSCManager::GetInt32(Message, 0, Value);
 					FrameNumber = Value;
+					FrameMessageCount = 1;
+				}
+				else if (Type == "frame_end")
+				{
+					// A frame may be split over several bundles; it's only complete once its
+					// end marker arrives and, if the sender told us, no message went missing.
+					int Frame = 0, ExpectedCount = 0;
+					UOSCManager::GetInt32(Message, 0, Frame);
+
+					if (Frame == FrameNumber
+						&& (!UOSCManager::GetInt32(Message, 1, ExpectedCount) || ExpectedCount == FrameMessageCount))
+					{
+						bFrameCompleted = true;
+					}
 				}
 			}
 		}
 	}
 
+	FlushSampleMessages();
+
 	// Update MultiSampleNum to minimum amount of Samples
 	for (auto Iter : OSCActorComponentMap)
 	{
@@ -272,10 +984,18 @@ void UOSCActorSubsystem::OnOscBundleReceived(const FOSCBundle& Bundle, const FSt
 
 		O->MultiSampleNum = MultiSampleNum;
 
-		if (O->UpdateFromOSC.IsBound())
-		{
-			FEditorScriptExecutionGuard ScriptGuard;
-			O->UpdateFromOSC.Broadcast();
-		}
+		RequestUpdate(O);
+	}
+
+	SyncEntityRenderers();
+
+	RunScheduledUpdates();
+
+	if (bFrameCompleted && FrameAckClient)
+	{
+		FOSCMessage Ack;
+		Ack.SetAddress(UOSCManager::ConvertStringToOSCAddress(TEXT("/sys/frame_ack")));
+		UOSCManager::AddInt32(Ack, FrameNumber);
+		FrameAckClient->SendOSCMessage(Ack);
 	}
 }
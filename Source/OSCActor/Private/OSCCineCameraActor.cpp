@@ -23,6 +23,24 @@ UOSCCineCameraComponent::UOSCCineCameraComponent()
 	bTickInEditor = true;
 }
 
+void UOSCCineCameraComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	UOSCActorSubsystem* S = GEngine ? GEngine->GetEngineSubsystem<UOSCActorSubsystem>() : nullptr;
+	if (S)
+		S->UpdateActorReference(this);
+}
+
+void UOSCCineCameraComponent::OnUnregister()
+{
+	UOSCActorSubsystem* S = GEngine ? GEngine->GetEngineSubsystem<UOSCActorSubsystem>() : nullptr;
+	if (S)
+		S->RemoveActorReference(this);
+
+	Super::OnUnregister();
+}
+
 void UOSCCineCameraComponent::BeginDestroy()
 {
 	UOSCActorSubsystem* S = GEngine->GetEngineSubsystem<UOSCActorSubsystem>();
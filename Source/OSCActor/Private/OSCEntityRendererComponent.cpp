@@ -0,0 +1,165 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OSCEntityRendererComponent.h"
+
+#include "OSCActorSubsystem.h"
+#include "OSCEntityTable.h"
+
+UOSCEntityRendererComponent::UOSCEntityRendererComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = true;
+	PrimaryComponentTick.TickGroup = ETickingGroup::TG_PrePhysics;
+	bTickInEditor = true;
+}
+
+void UOSCEntityRendererComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	UOSCActorSubsystem* S = GEngine ? GEngine->GetEngineSubsystem<UOSCActorSubsystem>() : nullptr;
+	if (S)
+		S->UpdateActorReference(this);
+}
+
+void UOSCEntityRendererComponent::OnUnregister()
+{
+	UOSCActorSubsystem* S = GEngine ? GEngine->GetEngineSubsystem<UOSCActorSubsystem>() : nullptr;
+	if (S)
+		S->RemoveActorReference(this);
+
+	Super::OnUnregister();
+}
+
+void UOSCEntityRendererComponent::BeginDestroy()
+{
+	UOSCActorSubsystem* S = GEngine->GetEngineSubsystem<UOSCActorSubsystem>();
+	if (S)
+		S->RemoveActorReference(this);
+
+	Super::BeginDestroy();
+}
+
+void UOSCEntityRendererComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+	FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	UOSCActorSubsystem* S = GEngine->GetEngineSubsystem<UOSCActorSubsystem>();
+	if (S)
+		S->UpdateActorReference(this);
+}
+
+void UOSCEntityRendererComponent::MarkSlotDirty(int32 Slot)
+{
+	if (DirtyBegin >= DirtyEnd)
+	{
+		DirtyBegin = Slot;
+		DirtyEnd = Slot + 1;
+	}
+	else
+	{
+		DirtyBegin = FMath::Min(DirtyBegin, Slot);
+		DirtyEnd = FMath::Max(DirtyEnd, Slot + 1);
+	}
+}
+
+void UOSCEntityRendererComponent::ResetMembers()
+{
+	Members.Reset();
+	DirtyBegin = DirtyEnd = 0;
+}
+
+void UOSCEntityRendererComponent::RemoveSlot(int32 Slot, FOSCEntityTable& Table)
+{
+	Members.RemoveAtSwap(Slot);
+
+	// Surplus instances are dropped in the next SyncInstances()
+	if (Slot < Members.Num())
+	{
+		Table.Slots[Members[Slot]] = Slot;
+		MarkSlotDirty(Slot);
+	}
+}
+
+void UOSCEntityRendererComponent::SyncInstances(FOSCEntityTable& Table)
+{
+	const int32 Num = Members.Num();
+
+	// Count or layout changes rebuild the render state, everything else is sent as an instance update
+	const bool bFullUpdate = GetInstanceCount() != Num || NumCustomDataFloats != CustomDataParams.Num();
+
+	if (bFullUpdate)
+	{
+		if (GetInstanceCount() < Num)
+		{
+			TArray<FTransform> NewInstances;
+			NewInstances.SetNum(Num - GetInstanceCount());
+			AddInstances(NewInstances, false);
+		}
+		else if (GetInstanceCount() > Num)
+		{
+			TArray<int32> RemovedInstances;
+			for (int32 i = GetInstanceCount() - 1; i >= Num; i--)
+				RemovedInstances.Add(i);
+			RemoveInstances(RemovedInstances);
+		}
+
+		NumCustomDataFloats = CustomDataParams.Num();
+		PerInstanceSMCustomData.SetNum(NumCustomDataFloats * Num);
+
+		DirtyBegin = 0;
+		DirtyEnd = Num;
+	}
+
+	DirtyEnd = FMath::Min(DirtyEnd, Num);
+	if (DirtyBegin >= DirtyEnd)
+		return;
+
+	TArray<int32> Columns;
+	for (const FString& Key : CustomDataParams)
+		Columns.Add(Table.GetParamColumn(Key, false));
+
+	static const FMatrix HIDDEN = FScaleMatrix::Make(FVector::ZeroVector);
+
+	TArray<FInstancedStaticMeshInstanceData> InstanceData;
+	InstanceData.SetNum(DirtyEnd - DirtyBegin);
+
+	TArray<float> Values;
+	Values.SetNumUninitialized(NumCustomDataFloats);
+
+	for (int32 Slot = DirtyBegin; Slot < DirtyEnd; Slot++)
+	{
+		const int32 Entity = Members[Slot];
+
+		// Hidden and promoted entities keep their instance slot, collapsed to zero scale
+		const bool bShow = Table.Visible[Entity] && !Table.Promoted[Entity];
+		InstanceData[Slot - DirtyBegin].Transform = bShow ? Table.Transforms[Entity].ToMatrixWithScale() : HIDDEN;
+
+		if (NumCustomDataFloats == 0)
+			continue;
+
+		for (int32 n = 0; n < NumCustomDataFloats; n++)
+			Values[n] = Columns[n] != INDEX_NONE ? Table.ParamColumns[Columns[n]][Entity] : 0;
+
+		// Written directly before a rebuild, recorded as instance updates otherwise
+		if (bFullUpdate)
+			FMemory::Memcpy(PerInstanceSMCustomData.GetData() + Slot * NumCustomDataFloats, Values.GetData(), NumCustomDataFloats * sizeof(float));
+		else
+			SetCustomData(Slot, Values, false);
+	}
+
+	BatchUpdateInstancesData(DirtyBegin, InstanceData.Num(), InstanceData.GetData(), bFullUpdate);
+
+	if (!bFullUpdate)
+	{
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+		MarkRenderInstancesDirty();
+#else
+		MarkRenderStateDirty();
+#endif
+	}
+
+	DirtyBegin = DirtyEnd = 0;
+}
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OSCEntityTable.h"
+
+int32 FOSCEntityTable::Add(const FString& Name, int32 Renderer, int32 Slot)
+{
+	const int32 Index = Names.Add(Name);
+	NameToIndex.Add(Name, Index);
+
+	Transforms.Add(FTransform::Identity);
+	Visible.Add(false);
+	Promoted.Add(false);
+	Renderers.Add(Renderer);
+	Slots.Add(Slot);
+	LastSeenTimes.Add(FPlatformTime::Seconds());
+
+	for (TArray<float>& Column : ParamColumns)
+		Column.Add(0);
+
+	return Index;
+}
+
+int32 FOSCEntityTable::RemoveAtSwap(int32 Entity)
+{
+	const int32 Last = Num() - 1;
+
+	NameToIndex.Remove(Names[Entity]);
+	if (Entity != Last)
+		NameToIndex.Add(Names[Last], Entity);
+
+	Names.RemoveAtSwap(Entity);
+	Transforms.RemoveAtSwap(Entity);
+	Renderers.RemoveAtSwap(Entity);
+	Slots.RemoveAtSwap(Entity);
+	LastSeenTimes.RemoveAtSwap(Entity);
+
+	for (TArray<float>& Column : ParamColumns)
+		Column.RemoveAtSwap(Entity);
+
+	// TBitArray has no swap-remove
+	Visible[Entity] = (bool)Visible[Last];
+	Visible.RemoveAt(Last);
+	Promoted[Entity] = (bool)Promoted[Last];
+	Promoted.RemoveAt(Last);
+
+	return Entity != Last ? Last : INDEX_NONE;
+}
+
+void FOSCEntityTable::Reset()
+{
+	Names.Reset();
+	Transforms.Reset();
+	Visible.Reset();
+	Promoted.Reset();
+	Renderers.Reset();
+	Slots.Reset();
+	LastSeenTimes.Reset();
+	ParamColumns.Reset();
+
+	NameToIndex.Reset();
+	ParamKeys.Reset();
+}
+
+int32 FOSCEntityTable::GetParamColumn(const FString& Key, bool bCreate)
+{
+	if (const int32* Column = ParamKeys.Find(Key))
+		return *Column;
+
+	if (!bCreate)
+		return INDEX_NONE;
+
+	const int32 Column = ParamColumns.AddDefaulted();
+	ParamColumns[Column].SetNumZeroed(Num());
+	ParamKeys.Add(Key, Column);
+
+	return Column;
+}
+
+float FOSCEntityTable::GetParam(int32 Entity, const FString& Key, float DefaultValue) const
+{
+	const int32* Column = ParamKeys.Find(Key);
+	if (!Column || !ParamColumns.IsValidIndex(*Column) || !ParamColumns[*Column].IsValidIndex(Entity))
+		return DefaultValue;
+
+	return ParamColumns[*Column][Entity];
+}
+
+void FOSCEntityTable::GetParams(int32 Entity, TMap<FString, float>& OutParams) const
+{
+	for (const auto& It : ParamKeys)
+		OutParams.Add(It.Key, ParamColumns[It.Value][Entity]);
+}
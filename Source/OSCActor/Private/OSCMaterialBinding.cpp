@@ -0,0 +1,175 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OSCMaterialBinding.h"
+
+#include "Engine/World.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+
+#if WITH_EDITOR
+void UOSCMaterialBindingAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	MarkBindingsChanged();
+}
+#endif
+
+// ===================================================================================
+
+static int32 GetChannelIndex(EOSCMaterialParameterChannel Channel)
+{
+	return Channel == EOSCMaterialParameterChannel::Scalar ? 0 : (int32)Channel - (int32)EOSCMaterialParameterChannel::R;
+}
+
+void FOSCMaterialBindingState::Resolve(UWorld* World, const UOSCMaterialBindingAsset* Asset, const TArray<UMaterialInstanceDynamic*>& Materials)
+{
+	Parameters.Reset();
+
+	ResolvedAsset = Asset;
+	ResolvedVersion = Asset ? Asset->GetVersion() : 0;
+	ResolvedWorld = World;
+	ResolvedMaterials.Reset(Materials.Num());
+	for (UMaterialInstanceDynamic* Material : Materials)
+		ResolvedMaterials.Add(Material);
+
+	if (!Asset)
+		return;
+
+	for (const FOSCMaterialParameterBinding& Binding : Asset->Bindings)
+	{
+		if (Binding.Key.IsEmpty() || Binding.ParameterName.IsNone())
+			continue;
+
+		UMaterialParameterCollectionInstance* CollectionInstance = nullptr;
+		if (Binding.Target == EOSCMaterialBindingTarget::ParameterCollection)
+		{
+			if (!Binding.Collection || !World)
+				continue;
+
+			CollectionInstance = World->GetParameterCollectionInstance(Binding.Collection);
+			if (!CollectionInstance)
+				continue;
+		}
+
+		const bool bVector = Binding.Channel != EOSCMaterialParameterChannel::Scalar;
+
+		// Channels of the same vector parameter share one entry
+		FResolvedParameter* Parameter = Parameters.FindByPredicate([&](const FResolvedParameter& P)
+		{
+			return P.Target == Binding.Target && P.ParameterName == Binding.ParameterName
+				&& P.bVector == bVector && P.CollectionInstance.Get() == CollectionInstance;
+		});
+
+		if (!Parameter || !bVector)
+		{
+			Parameter = &Parameters.AddDefaulted_GetRef();
+			Parameter->Target = Binding.Target;
+			Parameter->CollectionInstance = CollectionInstance;
+			Parameter->ParameterName = Binding.ParameterName;
+			Parameter->bVector = bVector;
+
+			// Start from the current value so unbound vector channels are preserved
+			if (CollectionInstance)
+			{
+				if (bVector)
+					CollectionInstance->GetVectorParameterValue(Binding.ParameterName, Parameter->Value);
+				else
+					CollectionInstance->GetScalarParameterValue(Binding.ParameterName, Parameter->Value.R);
+			}
+			else
+			{
+				for (UMaterialInstanceDynamic* Material : Materials)
+				{
+					int32 Index = INDEX_NONE;
+
+					if (IsValid(Material))
+					{
+						if (bVector)
+						{
+							const FLinearColor Current = Material->K2_GetVectorParameterValue(Binding.ParameterName);
+							Material->InitializeVectorParameterAndGetIndex(Binding.ParameterName, Current, Index);
+							if (Parameter->MaterialIndices.Num() == 0)
+								Parameter->Value = Current;
+						}
+						else
+						{
+							const float Current = Material->K2_GetScalarParameterValue(Binding.ParameterName);
+							Material->InitializeScalarParameterAndGetIndex(Binding.ParameterName, Current, Index);
+							if (Parameter->MaterialIndices.Num() == 0)
+								Parameter->Value.R = Current;
+						}
+					}
+
+					Parameter->MaterialIndices.Add(Index);
+				}
+			}
+		}
+
+		Parameter->Keys[GetChannelIndex(Binding.Channel)] = Binding.Key;
+	}
+}
+
+void FOSCMaterialBindingState::Apply(UWorld* World, const UOSCMaterialBindingAsset* Asset, const TArray<UMaterialInstanceDynamic*>& Materials, const TMap<FString, float>& Params)
+{
+	bool bNeedsResolve = Asset != ResolvedAsset || (Asset && Asset->GetVersion() != ResolvedVersion)
+		|| World != ResolvedWorld.Get() || Materials.Num() != ResolvedMaterials.Num();
+	for (int32 i = 0; !bNeedsResolve && i < Materials.Num(); i++)
+		bNeedsResolve = ResolvedMaterials[i].Get() != Materials[i];
+
+	if (bNeedsResolve)
+		Resolve(World, Asset, Materials);
+
+	for (FResolvedParameter& Parameter : Parameters)
+	{
+		FLinearColor Value = Parameter.Value;
+		bool bReceived = false;
+
+		const int32 ChannelNum = Parameter.bVector ? 4 : 1;
+		for (int32 c = 0; c < ChannelNum; c++)
+		{
+			if (Parameter.Keys[c].IsEmpty())
+				continue;
+
+			if (const float* V = Params.Find(Parameter.Keys[c]))
+			{
+				Value.Component(c) = *V;
+				bReceived = true;
+			}
+		}
+
+		if (!bReceived || (Parameter.bHasValue && Value == Parameter.Value))
+			continue;
+
+		Parameter.Value = Value;
+		Parameter.bHasValue = true;
+
+		if (Parameter.Target == EOSCMaterialBindingTarget::ParameterCollection)
+		{
+			UMaterialParameterCollectionInstance* Instance = Parameter.CollectionInstance.Get();
+			if (!Instance)
+				continue;
+
+			if (Parameter.bVector)
+				Instance->SetVectorParameterValue(Parameter.ParameterName, Value);
+			else
+				Instance->SetScalarParameterValue(Parameter.ParameterName, Value.R);
+		}
+		else
+		{
+			for (int32 i = 0; i < Parameter.MaterialIndices.Num(); i++)
+			{
+				UMaterialInstanceDynamic* Material = Materials[i];
+				const int32 Index = Parameter.MaterialIndices[i];
+				if (Index == INDEX_NONE || !IsValid(Material))
+					continue;
+
+				if (Parameter.bVector)
+					Material->SetVectorParameterByIndex(Index, Value);
+				else
+					Material->SetScalarParameterByIndex(Index, Value.R);
+			}
+		}
+	}
+}
@@ -0,0 +1,321 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "OSCPropertyBinding.h"
+
+#include "Components/SceneComponent.h"
+#include "GameFramework/Actor.h"
+#include "OSCActor.h"
+
+static UObject* FindBindingTarget(AActor* Owner, FName ComponentName)
+{
+	if (ComponentName.IsNone())
+		return Owner;
+
+	for (UActorComponent* Component : Owner->GetComponents())
+	{
+		if (Component && Component->GetFName() == ComponentName)
+			return Component;
+	}
+
+	return nullptr;
+}
+
+void FOSCPropertyBindingState::Resolve(AActor* Owner, const TArray<FOSCPropertyBinding>& Bindings, uint32 BindingsVersion)
+{
+	static const FName TRANSFORM_PROPERTIES[] = {
+		FName("RelativeLocation"),
+		FName("RelativeRotation"),
+		FName("RelativeScale3D"),
+	};
+
+	Targets.Reset();
+
+	bResolved = true;
+	ResolvedOwner = Owner;
+	ResolvedBindingsVersion = BindingsVersion;
+	ResolvedBindingsNum = Bindings.Num();
+
+	if (!IsValid(Owner))
+		return;
+
+	for (int32 BindingIndex = 0; BindingIndex < Bindings.Num(); BindingIndex++)
+	{
+		const FOSCPropertyBinding& Binding = Bindings[BindingIndex];
+		if (Binding.Key.IsEmpty() || Binding.PropertyPath.IsEmpty())
+			continue;
+
+		UObject* Object = FindBindingTarget(Owner, Binding.ComponentName);
+		if (!Object)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("OSCActor: %s has no component named %s"), *Owner->GetName(), *Binding.ComponentName.ToString());
+			continue;
+		}
+
+		TArray<FString> Segments;
+		Binding.PropertyPath.ParseIntoArray(Segments, TEXT("."), true);
+
+		const UStruct* Struct = Object->GetClass();
+		const FProperty* TopProperty = nullptr;
+		const FProperty* Leaf = nullptr;
+		int32 Offset = 0;
+
+		for (int32 i = 0; i < Segments.Num(); i++)
+		{
+			Leaf = Struct ? FindFProperty<FProperty>(Struct, FName(*Segments[i])) : nullptr;
+			if (!Leaf)
+				break;
+
+			if (!TopProperty)
+				TopProperty = Leaf;
+			else
+				Offset += Leaf->GetOffset_ForInternal();
+
+			const FStructProperty* StructProperty = CastField<FStructProperty>(Leaf);
+			Struct = StructProperty ? StructProperty->Struct : nullptr;
+		}
+
+		FResolvedBinding Resolved;
+		Resolved.BindingIndex = BindingIndex;
+		Resolved.TopProperty = TopProperty;
+		Resolved.TopOffset = TopProperty ? TopProperty->GetOffset_ForInternal() : 0;
+
+		bool bValid = Leaf != nullptr;
+		if (bValid)
+		{
+			const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Leaf);
+			if (ArrayProperty && (ArrayProperty->Inner->IsA<FFloatProperty>() || ArrayProperty->Inner->IsA<FDoubleProperty>()))
+			{
+				Resolved.ArrayProperty = ArrayProperty;
+				Resolved.ArrayOffset = Offset;
+			}
+			else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Leaf))
+			{
+				for (TFieldIterator<FProperty> It(StructProperty->Struct); It; ++It)
+					AddField(*It, Offset + It->GetOffset_ForInternal(), Resolved.Fields);
+			}
+			else
+			{
+				AddField(Leaf, Offset, Resolved.Fields);
+			}
+
+			bValid = Resolved.ArrayProperty || Resolved.Fields.Num() > 0;
+		}
+
+		if (!bValid)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("OSCActor: can't bind %s to %s.%s"), *Binding.Key, *Object->GetName(), *Binding.PropertyPath);
+			continue;
+		}
+
+		FTarget* Target = Targets.FindByPredicate([Object](const FTarget& T) { return T.Object.Get() == Object; });
+		if (!Target)
+		{
+			Target = &Targets.AddDefaulted_GetRef();
+			Target->Object = Object;
+		}
+
+		for (const FName& Name : TRANSFORM_PROPERTIES)
+		{
+			if (TopProperty->GetFName() == Name && Object->IsA<USceneComponent>())
+				Resolved.bTransform = true;
+		}
+
+		Target->Bindings.Add(MoveTemp(Resolved));
+	}
+}
+
+bool FOSCPropertyBindingState::AddField(const FProperty* Property, int32 Offset, TArray<FField>& OutFields)
+{
+	if (const FBoolProperty* Bool = CastField<FBoolProperty>(Property))
+	{
+		OutFields.Add({ nullptr, Bool, Offset });
+		return true;
+	}
+
+	const FNumericProperty* Numeric = CastField<FNumericProperty>(Property);
+	if (Numeric && !Numeric->IsEnum())
+	{
+		OutFields.Add({ Numeric, nullptr, Offset });
+		return true;
+	}
+
+	return false;
+}
+
+bool FOSCPropertyBindingState::Write(const FResolvedBinding& Binding, uint8* Value, const float* Scalar, const TArray<float>* Samples) const
+{
+	bool bChanged = false;
+
+	if (Binding.ArrayProperty)
+	{
+		FScriptArrayHelper Helper(Binding.ArrayProperty, Value + Binding.ArrayOffset);
+		const int32 Num = Samples ? Samples->Num() : 1;
+		const float* Src = Samples ? Samples->GetData() : Scalar;
+
+		if (Helper.Num() != Num)
+		{
+			Helper.Resize(Num);
+			bChanged = true;
+		}
+
+		if (Num == 0)
+			return bChanged;
+
+		if (Binding.ArrayProperty->Inner->IsA<FFloatProperty>())
+		{
+			float* Dst = (float*)Helper.GetRawPtr(0);
+			if (bChanged || FMemory::Memcmp(Dst, Src, Num * sizeof(float)) != 0)
+			{
+				FMemory::Memcpy(Dst, Src, Num * sizeof(float));
+				bChanged = true;
+			}
+		}
+		else
+		{
+			double* Dst = (double*)Helper.GetRawPtr(0);
+			for (int32 i = 0; i < Num; i++)
+			{
+				if (Dst[i] != Src[i])
+				{
+					Dst[i] = Src[i];
+					bChanged = true;
+				}
+			}
+		}
+
+		return bChanged;
+	}
+
+	// An ss value goes to every field (uniform scale, grey color, ...), ms samples fill the fields in order
+	const int32 Num = Samples ? FMath::Min(Samples->Num(), Binding.Fields.Num()) : Binding.Fields.Num();
+
+	for (int32 i = 0; i < Num; i++)
+	{
+		const FField& Field = Binding.Fields[i];
+		const float Src = Samples ? (*Samples)[i] : *Scalar;
+		void* Dst = Value + Field.Offset;
+
+		if (Field.Bool)
+		{
+			const bool b = Src != 0;
+			if (Field.Bool->GetPropertyValue(Dst) != b)
+			{
+				Field.Bool->SetPropertyValue(Dst, b);
+				bChanged = true;
+			}
+		}
+		else if (Field.Numeric->IsFloatingPoint())
+		{
+			if (Field.Numeric->GetFloatingPointPropertyValue(Dst) != Src)
+			{
+				Field.Numeric->SetFloatingPointPropertyValue(Dst, Src);
+				bChanged = true;
+			}
+		}
+		else
+		{
+			const int64 v = FMath::RoundToInt(Src);
+			if (Field.Numeric->GetSignedIntPropertyValue(Dst) != v)
+			{
+				Field.Numeric->SetIntPropertyValue(Dst, v);
+				bChanged = true;
+			}
+		}
+	}
+
+	return bChanged;
+}
+
+void FOSCPropertyBindingState::Apply(AActor* Owner, const TArray<FOSCPropertyBinding>& Bindings, uint32 BindingsVersion,
+	const TMap<FString, float>& Params, const TMap<FString, FChannelData>& MultiSampleParams)
+{
+	// The count is checked too so rows added or removed without a version bump can't index past the end
+	if (!bResolved || Owner != ResolvedOwner.Get() || BindingsVersion != ResolvedBindingsVersion || Bindings.Num() != ResolvedBindingsNum)
+		Resolve(Owner, Bindings, BindingsVersion);
+
+	for (const FTarget& Target : Targets)
+	{
+		UObject* Object = Target.Object.Get();
+		if (!IsValid(Object))
+			continue;
+
+		bool bTransformChanged = false;
+		bool bRenderStateChanged = false;
+
+		for (const FResolvedBinding& Resolved : Target.Bindings)
+		{
+			const FOSCPropertyBinding& Binding = Bindings[Resolved.BindingIndex];
+
+			const float* Scalar = nullptr;
+			const TArray<float>* Samples = nullptr;
+
+			if (Binding.bMultiSample)
+			{
+				const FChannelData* Data = MultiSampleParams.Find(Binding.Key);
+				if (!Data)
+					continue;
+				Samples = &Data->Samples;
+			}
+			else
+			{
+				Scalar = Params.Find(Binding.Key);
+				if (!Scalar)
+					continue;
+			}
+
+			const FProperty* TopProperty = Resolved.TopProperty;
+			uint8* Value = (uint8*)Object + Resolved.TopOffset;
+
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+			// Properties with a native setter are written through it on a copy of the value
+			if (TopProperty->HasSetter())
+			{
+				Scratch.SetNumUninitialized(TopProperty->GetSize());
+				uint8* Copy = Scratch.GetData();
+
+				TopProperty->InitializeValue(Copy);
+				TopProperty->GetValue_InContainer(Object, Copy);
+
+				// The setter is responsible for updating the object, except for the
+				// transform setters that only store the value (SetRelativeLocation_Direct)
+				if (Write(Resolved, Copy, Scalar, Samples))
+				{
+					TopProperty->CallSetter(Object, Copy);
+					bTransformChanged |= Resolved.bTransform;
+				}
+
+				TopProperty->DestroyValue(Copy);
+				continue;
+			}
+#endif
+
+			if (Write(Resolved, Value, Scalar, Samples))
+			{
+				if (Resolved.bTransform)
+					bTransformChanged = true;
+				else
+					bRenderStateChanged = true;
+			}
+		}
+
+		// Actor properties may have been copied into any of its components' render state
+		if (AActor* Actor = Cast<AActor>(Object))
+		{
+			if (bRenderStateChanged)
+				Actor->MarkComponentsRenderStateDirty();
+			continue;
+		}
+
+		UActorComponent* Component = Cast<UActorComponent>(Object);
+		if (!Component)
+			continue;
+
+		// Transform changes only move the proxy, recreating it is reserved for other
+		// properties the render state may have copied
+		if (bTransformChanged)
+			CastChecked<USceneComponent>(Component)->UpdateComponentToWorld();
+
+		if (bRenderStateChanged)
+			Component->MarkRenderStateDirty();
+	}
+}
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "OSCActor.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOSCActorChannelDirtyRunsTest, "OSCActor.ChannelData.DirtyRuns",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FOSCActorChannelDirtyRunsTest::RunTest(const FString& Parameters)
+{
+	const int32 Num = 10000;
+
+	TMap<FString, FChannelData> Channels;
+	Channels.Add(TEXT("tx"));
+	Channels.Add(TEXT("ty"));
+
+	// References taken after all adds, adding may move the elements
+	FChannelData& X = Channels.FindChecked(TEXT("tx"));
+	FChannelData& Y = Channels.FindChecked(TEXT("ty"));
+	X.Resize(Num);
+	Y.Resize(Num);
+
+	TArray<FIntPoint> Runs;
+
+	// A new channel is dirty as a whole, a cleared one not at all
+	FChannelData::GetDirtyRuns(Channels, Num, Runs);
+	TestEqual(TEXT("resized channel"), Runs, TArray<FIntPoint>({ FIntPoint(0, Num) }));
+
+	X.ClearDirty();
+	Y.ClearDirty();
+	FChannelData::GetDirtyRuns(Channels, Num, Runs);
+	TestEqual(TEXT("cleared"), Runs.Num(), 0);
+	TestFalse(TEXT("not dirty"), X.IsDirty());
+
+	// Scattered patches stay separate runs instead of spanning the whole array
+	X.MarkDirty(3, 4);
+	X.MarkDirty(5000, 5001);
+	Y.MarkDirty(9990, 9991);
+	Y.MarkDirty(5001, 5003);
+	FChannelData::GetDirtyRuns(Channels, Num, Runs);
+	TestEqual(TEXT("scattered"), Runs, TArray<FIntPoint>({ FIntPoint(3, 4), FIntPoint(5000, 5003), FIntPoint(9990, 9991) }));
+
+	int32 Covered = 0;
+	for (const FIntPoint& Run : Runs)
+		Covered += Run.Y - Run.X;
+	TestEqual(TEXT("samples uploaded"), Covered, 5);
+
+	// Neighbours a few samples apart are sent as one batch
+	X.MarkDirty(10, 11);
+	X.MarkDirty(13, 14);
+	FChannelData::GetDirtyRuns(Channels, Num, Runs);
+	TestEqual(TEXT("merged neighbours"), Runs[1], FIntPoint(10, 14));
+
+	// Samples past the shortest channel are ignored
+	FChannelData::GetDirtyRuns(Channels, 5001, Runs);
+	TestEqual(TEXT("clamped"), Runs.Last(), FIntPoint(5000, 5001));
+
+	// Shrinking drops dirty bits past the end, growing marks only the new samples
+	Y.ClearDirty();
+	Y.Resize(9000);
+	Y.Resize(9500);
+	X.ClearDirty();
+	FChannelData::GetDirtyRuns(Channels, Num, Runs);
+	TestEqual(TEXT("resize"), Runs, TArray<FIntPoint>({ FIntPoint(9000, 9500) }));
+
+	// A full ms message dirties everything
+	X.MarkAllDirty();
+	FChannelData::GetDirtyRuns(Channels, Num, Runs);
+	TestEqual(TEXT("full message"), Runs, TArray<FIntPoint>({ FIntPoint(0, Num) }));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,211 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "OSCActorSharedMemory.h"
+#include "OSCManager.h"
+
+using namespace OSCActorSharedMemory;
+
+// Hand-rolled OSC encoder, independent of the decoder under test
+struct FTestPacket
+{
+	TArray<uint8> Bytes;
+
+	void U32(uint32 Value)
+	{
+		Bytes.Add(uint8(Value >> 24));
+		Bytes.Add(uint8(Value >> 16));
+		Bytes.Add(uint8(Value >> 8));
+		Bytes.Add(uint8(Value));
+	}
+
+	void Str(const ANSICHAR* Value)
+	{
+		Bytes.Append((const uint8*)Value, FCStringAnsi::Strlen(Value) + 1);
+		while (Bytes.Num() % 4)
+			Bytes.Add(0);
+	}
+
+	void Float(float Value)
+	{
+		uint32 Bits;
+		FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+		U32(Bits);
+	}
+
+	void BundleHeader(uint64 TimeTag = 1)
+	{
+		Str("#bundle");
+		U32(uint32(TimeTag >> 32));
+		U32(uint32(TimeTag));
+	}
+
+	void Element(const FTestPacket& Element)
+	{
+		U32(Element.Bytes.Num());
+		Bytes.Append(Element.Bytes);
+	}
+};
+
+static FTestPacket MakeFramePacket(int32 Frame)
+{
+	FTestPacket FrameNumber;
+	FrameNumber.Str("/sys/frame_number");
+	FrameNumber.Str(",i");
+	FrameNumber.U32(Frame);
+
+	FTestPacket TRS;
+	TRS.Str("/obj/a/TRS");
+	TRS.Str(",fffffffff");
+	for (int32 i = 0; i < 9; i++)
+		TRS.Float(float(i));
+
+	FTestPacket Active;
+	Active.Str("/obj/a/active");
+	Active.Str(",T");
+
+	FTestPacket Name;
+	Name.Str("/obj/a/name");
+	Name.Str(",s");
+	Name.Str("abc");
+
+	FTestPacket Inner;
+	Inner.Str("/x");
+	Inner.Str(",i");
+	Inner.U32(1);
+
+	FTestPacket Nested;
+	Nested.BundleHeader();
+	Nested.Element(Inner);
+
+	FTestPacket Packet;
+	Packet.BundleHeader((uint64(3900000000u) << 32) | 0x80000000u);
+	Packet.Element(FrameNumber);
+	Packet.Element(TRS);
+	Packet.Element(Active);
+	Packet.Element(Name);
+	Packet.Element(Nested);
+	return Packet;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOSCActorSharedMemoryDecodeTest, "OSCActor.SharedMemory.DecodePacket",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FOSCActorSharedMemoryDecodeTest::RunTest(const FString& Parameters)
+{
+	const FTestPacket Packet = MakeFramePacket(7);
+
+	TArray<FOSCMessage> Messages;
+	uint64 TimeTag = 0;
+	TestTrue(TEXT("decodes"), FOSCActorSharedMemoryReceiver::DecodePacket(Packet.Bytes.GetData(), Packet.Bytes.Num(), Messages, &TimeTag));
+	if (!TestEqual(TEXT("message count"), Messages.Num(), 5))
+		return false;
+
+	// The outermost bundle's time tag is reported, not the nested one
+	TestEqual(TEXT("time tag"), TimeTag, (uint64(3900000000u) << 32) | 0x80000000u);
+
+	TestEqual(TEXT("address 0"), Messages[0].GetAddress().GetFullPath(), FString(TEXT("/sys/frame_number")));
+	int32 Frame = 0;
+	TestTrue(TEXT("frame arg"), UOSCManager::GetInt32(Messages[0], 0, Frame));
+	TestEqual(TEXT("frame"), Frame, 7);
+
+	TArray<float> Floats;
+	UOSCManager::GetAllFloats(Messages[1], Floats);
+	TestEqual(TEXT("TRS floats"), Floats.Num(), 9);
+	if (Floats.Num() == 9)
+		TestEqual(TEXT("TRS value"), Floats[8], 8.0f);
+
+	bool bActive = false;
+	TestTrue(TEXT("bool arg"), UOSCManager::GetBool(Messages[2], 0, bActive));
+	TestTrue(TEXT("active"), bActive);
+
+	FString Name;
+	TestTrue(TEXT("string arg"), UOSCManager::GetString(Messages[3], 0, Name));
+	TestEqual(TEXT("name"), Name, FString(TEXT("abc")));
+
+	TestEqual(TEXT("nested address"), Messages[4].GetAddress().GetFullPath(), FString(TEXT("/x")));
+
+	// Truncated packets and elements running past the end are rejected
+	Messages.Reset();
+	TestFalse(TEXT("truncated"), FOSCActorSharedMemoryReceiver::DecodePacket(Packet.Bytes.GetData(), Packet.Bytes.Num() - 2, Messages));
+
+	FTestPacket Oversized;
+	Oversized.BundleHeader();
+	Oversized.U32(1024);
+	Oversized.U32(0);
+	Messages.Reset();
+	TestFalse(TEXT("element past end"), FOSCActorSharedMemoryReceiver::DecodePacket(Oversized.Bytes.GetData(), Oversized.Bytes.Num(), Messages));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOSCActorSharedMemoryReceiveTest, "OSCActor.SharedMemory.Receive",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FOSCActorSharedMemoryReceiveTest::RunTest(const FString& Parameters)
+{
+	const uint32 SlotCount = 4;
+	const uint32 SlotSize = 1024;
+	const FString Name = FString::Printf(TEXT("OSCActorTest%u"), FPlatformProcess::GetCurrentProcessId());
+
+	FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapNamedSharedMemoryRegion(
+		Name, true, FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write, RegionSize(SlotCount, SlotSize));
+	if (!TestNotNull(TEXT("region"), Region))
+		return false;
+
+	uint8* Base = (uint8*)Region->GetAddress();
+	FMemory::Memzero(Base, RegionSize(SlotCount, SlotSize));
+
+	FHeader* Header = (FHeader*)Base;
+	Header->Version = Version;
+	Header->SlotCount = SlotCount;
+	Header->SlotSize = SlotSize;
+	Header->Generation = 1;
+	Header->Magic = Magic;
+
+	auto Publish = [&](int32 Frame)
+	{
+		const FTestPacket Packet = MakeFramePacket(Frame);
+		const uint64 Index = Header->PublishedCount;
+
+		FSlotHeader* Slot = (FSlotHeader*)(Base + sizeof(FHeader) + SlotStride(SlotSize) * (Index % SlotCount));
+		FMemory::Memcpy(Slot + 1, Packet.Bytes.GetData(), Packet.Bytes.Num());
+		Slot->Size = Packet.Bytes.Num();
+		Slot->Sequence = (Index + 1) * 2;
+		Header->PublishedCount = Index + 1;
+	};
+
+	TArray<int32> Frames;
+	auto Collect = [&Frames](const TArray<FOSCMessage>& Messages, uint64 TimeTag)
+	{
+		int32 Frame = -1;
+		if (Messages.Num() > 0)
+			UOSCManager::GetInt32(Messages[0], 0, Frame);
+		Frames.Add(Frame);
+	};
+
+	FOSCActorSharedMemoryReceiver Receiver(Name);
+
+	// A new region starts from its newest packet
+	Publish(0);
+	Publish(1);
+	TestEqual(TEXT("first poll"), Receiver.Poll(Collect), 1);
+	TestEqual(TEXT("newest first"), Frames.Num() == 1 ? Frames[0] : -1, 1);
+
+	// Nothing new, nothing delivered
+	TestEqual(TEXT("idle poll"), Receiver.Poll(Collect), 0);
+
+	// Packets that were not overwritten yet are delivered in order
+	Publish(2);
+	Publish(3);
+	TestEqual(TEXT("second poll"), Receiver.Poll(Collect), 2);
+	TestEqual(TEXT("in order"), Frames, TArray<int32>({ 1, 2, 3 }));
+
+	FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
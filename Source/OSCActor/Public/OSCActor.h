@@ -4,9 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "OSCMaterialBinding.h"
+#include "OSCPropertyBinding.h"
 #include "OSCActor.generated.h"
 
 class UInstancedStaticMeshComponent;
+class UMaterialInstanceDynamic;
 
 USTRUCT()
 struct FChannelData
@@ -14,6 +17,121 @@ struct FChannelData
 	GENERATED_BODY()
 
 	TArray<float> Samples;
+
+	// Samples changed since the last frame_number. A full ms message marks the whole channel,
+	// msp patches mark single samples so scattered indices don't widen into one big range.
+	TBitArray<> DirtyBits;
+	bool bAllDirty = false;
+
+	void MarkAllDirty() { bAllDirty = true; }
+
+	void MarkDirty(int32 Begin, int32 End)
+	{
+		if (bAllDirty || Begin >= End)
+			return;
+
+		if (DirtyBits.Num() < End)
+			DirtyBits.Add(false, End - DirtyBits.Num());
+
+		DirtyBits.SetRange(Begin, End - Begin, true);
+	}
+
+	// Resizes the channel, new samples are zero and dirty
+	void Resize(int32 Num)
+	{
+		const int32 OldNum = Samples.Num();
+		Samples.SetNumZeroed(Num);
+
+		if (DirtyBits.Num() > Num)
+			DirtyBits.SetNum(Num, false);
+
+		MarkDirty(OldNum, Num);
+	}
+
+	bool IsDirty() const { return bAllDirty || DirtyBits.Find(true) != INDEX_NONE; }
+
+	void ClearDirty()
+	{
+		bAllDirty = false;
+		DirtyBits.Init(false, DirtyBits.Num());
+	}
+
+	// Union of the dirty samples of all channels below Num as sorted [X, Y) runs. Runs only a
+	// few samples apart are merged, one batch update is cheaper than several tiny ones.
+	static void GetDirtyRuns(const TMap<FString, FChannelData>& Channels, int32 Num, TArray<FIntPoint>& OutRuns);
+};
+
+// One instanced mesh filled by UOSCActorComponent::UpdateInstancedStaticMeshes
+USTRUCT(BlueprintType)
+struct FOSCInstancedMeshTarget
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OSCActor")
+	UInstancedStaticMeshComponent* InstancedStaticMesh = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OSCActor")
+	TArray<FString> CustomDataChannels;
+};
+
+// Every value of a scalar parameter in arrival order, read in one window per engine frame
+USTRUCT()
+struct FParamHistory
+{
+	GENERATED_BODY()
+
+	// Entries are written twice, at i and i + Capacity, so any run of up to
+	// Capacity entries can be returned as one contiguous view.
+	TArray<float> Values;
+	TArray<double> Timestamps;
+
+	int32 Capacity = 0;
+
+	// Entries written so far
+	uint64 Total = 0;
+
+	// Entries [WindowBegin, WindowEnd) are visible to readers, see UpdateWindow()
+	mutable uint64 WindowBegin = 0;
+	mutable uint64 WindowEnd = 0;
+	mutable uint64 WindowFrame = 0;
+
+	void Add(float Value, double Timestamp, int32 InCapacity)
+	{
+		InCapacity = FMath::Max(InCapacity, 1);
+		if (Capacity != InCapacity)
+		{
+			Capacity = InCapacity;
+			Values.SetNumZeroed(Capacity * 2);
+			Timestamps.SetNumZeroed(Capacity * 2);
+			WindowBegin = WindowEnd = Total;
+		}
+
+		const int32 Index = (int32)(Total % Capacity);
+		Values[Index] = Values[Index + Capacity] = Value;
+		Timestamps[Index] = Timestamps[Index + Capacity] = Timestamp;
+
+		Total++;
+	}
+
+	// The first read of an engine frame starts a new window right after the previous
+	// one, later reads in the same frame extend it to the newest entry.
+	void UpdateWindow(uint64 InFrameCounter) const
+	{
+		if (WindowFrame != InFrameCounter)
+		{
+			WindowFrame = InFrameCounter;
+			WindowBegin = WindowEnd;
+		}
+
+		WindowEnd = Total;
+		WindowBegin = FMath::Max(WindowBegin, Total - FMath::Min(Total, (uint64)Capacity));
+	}
+
+	int32 GetStart() const { return Capacity > 0 ? (int32)(WindowBegin % Capacity) : 0; }
+	int32 GetNum() const { return (int32)(WindowEnd - WindowBegin); }
+
+	TArrayView<const float> GetValues() const { return MakeArrayView(Values.GetData() + GetStart(), GetNum()); }
+	TArrayView<const double> GetTimestamps() const { return MakeArrayView(Timestamps.GetData() + GetStart(), GetNum()); }
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FUpdateFromOSCDelegate);
@@ -29,8 +147,13 @@ public:
 	
 	UOSCActorComponent();
 	
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
 	virtual void BeginDestroy() override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 
 public:
 
@@ -48,14 +171,116 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "OSCActor")
 	void UpdateInstancedStaticMesh(UInstancedStaticMeshComponent* InstancedStaticMesh, TArray<FString> InCustomDataChannels);
 
+	// Distributes the samples over several instanced meshes in one pass: sample i goes to
+	// Targets[MeshIndexChannel[i]]. Samples without an index, or with one outside Targets, are
+	// dropped. A mesh listed more than once only receives the samples of its first entry.
+	// Instances are packed per mesh, so with bKeepInstancePhysics bodies are added or removed
+	// whenever a mesh's share of the samples changes, and bodies of remaining instances get
+	// teleported to whichever sample now lands on them.
+	UFUNCTION(BlueprintCallable, Category = "OSCActor")
+	void UpdateInstancedStaticMeshes(const TArray<FOSCInstancedMeshTarget>& Targets, const FString& MeshIndexChannel);
+
+	// Keep collision of instances updated by UpdateInstancedStaticMesh: bodies are moved with
+	// batched kinematic teleports and only created / destroyed when the instance count changes
+	UPROPERTY(Category = "OSCActor", EditAnywhere, BlueprintReadWrite)
+	bool bKeepInstancePhysics = false;
+
+	// Keep received values across frame_number instead of clearing them, so senders
+	// can patch individual samples with sparse "msp" messages
+	UPROPERTY(Category = "OSCActor", EditAnywhere, BlueprintReadWrite)
+	bool bPersistentChannels = false;
+
+	// Smallest range covering every sample changed since the last frame_number
+	UFUNCTION(BlueprintCallable, Category = "OSCActor")
+	bool GetMultiSampleDirtyRange(int32& OutBegin, int32& OutEnd) const;
+
+	// Sample runs [X, Y) changed since the last frame_number over all channels, sorted
+	UFUNCTION(BlueprintCallable, Category = "OSCActor")
+	bool GetMultiSampleDirtyRuns(TArray<FIntPoint>& OutRuns) const;
+
+	// Record every ss value received, not only the last one, see GetOSCParamHistory
+	UPROPERTY(Category = "OSCActor", EditAnywhere, BlueprintReadWrite)
+	bool bRecordParamHistory = false;
+
+	UPROPERTY(Category = "OSCActor", EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1", EditCondition = "bRecordParamHistory"))
+	int32 ParamHistoryCapacity = 16;
+
+	// Values of Key received since the previous engine frame's reads, oldest first, with timestamps
+	// in FPlatformTime::Seconds(). A timestamp is the sender's OSC time tag when the bundle carries
+	// one (shared memory transport), otherwise the time the packet was dispatched on the game
+	// thread. UDP packets are queued by the OSC server until the engine ticks, so dispatch times
+	// bunch up per frame and must not be used to integrate over. Reading once per frame, e.g. in
+	// Tick, returns every value exactly once whether the bundles were dispatched before or after
+	// the read. Within a frame the window only grows, so the last UpdateFromOSC of a frame sees
+	// all of that frame's values. At most ParamHistoryCapacity values are kept between reads.
+	UFUNCTION(BlueprintCallable, Category = "OSCActor")
+	int32 GetOSCParamHistory(const FString& Key, TArray<float>& OutValues, TArray<double>& OutTimestamps) const;
+
+	TArrayView<const float> GetOSCParamHistoryView(const FString& Key, TArrayView<const double>* OutTimestamps = nullptr) const;
+
+	// ss keys written straight into material parameter collections and the bound dynamic
+	// materials every frame, without going through UpdateFromOSC
+	UPROPERTY(Category = "OSCActor", EditAnywhere, BlueprintReadWrite)
+	UOSCMaterialBindingAsset* MaterialBindings;
+
+	UFUNCTION(BlueprintCallable, Category = "OSCActor")
+	void AddBoundMaterial(UMaterialInstanceDynamic* Material);
+
+	UFUNCTION(BlueprintCallable, Category = "OSCActor")
+	void RemoveBoundMaterial(UMaterialInstanceDynamic* Material);
+
+	void ApplyMaterialBindings();
+
+	// ss / ms keys copied into properties of the owner and its components every frame,
+	// without going through UpdateFromOSC. Call RefreshPropertyBindings after changing
+	// rows from code or Blueprint.
+	UPROPERTY(Category = "OSCActor", EditAnywhere, BlueprintReadWrite)
+	TArray<FOSCPropertyBinding> PropertyBindings;
+
+	// Resolves PropertyBindings again, e.g. after rows were edited or components were added at runtime
+	UFUNCTION(BlueprintCallable, Category = "OSCActor")
+	void RefreshPropertyBindings();
+
+	void ApplyPropertyBindings();
+
+	// Order of updates when UOSCActorSettings::UpdateBudgetMs is exceeded, higher first
+	UPROPERTY(Category = "OSCActor|Scheduler", EditAnywhere, BlueprintReadWrite)
+	float UpdatePriority = 1;
+
+	// Updates per second guaranteed even over budget, 0 for none
+	UPROPERTY(Category = "OSCActor|Scheduler", EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float MinUpdateRate = 0;
+
+	UPROPERTY(Category = "OSCActor|Scheduler", EditAnywhere, BlueprintReadWrite)
+	bool bDeprioritizeWhenNotRendered = true;
+
 	UPROPERTY(BlueprintAssignable, DisplayName="Update From OSC", Category = "OSCActor")
 	FUpdateFromOSCDelegate UpdateFromOSC;
 	
 private:
 
+	void GetCustomDataChannels(const TArray<FString>& InCustomDataChannels, TArray<const TArray<float>*>& OutChannels);
+
+	UPROPERTY(Transient)
+	TArray<UMaterialInstanceDynamic*> BoundMaterials;
+
+	FOSCMaterialBindingState MaterialBindingState;
+	FOSCPropertyBindingState PropertyBindingState;
+	uint32 PropertyBindingsVersion = 0;
+
 	TMap<FString, float> Params;
 	TMap<FString, FChannelData> MultiSampleParams;
+	TMap<FString, FParamHistory> ParamHistory;
 	int MultiSampleNum = 0;
+
+	// UpdateInstancedStaticMeshes warnings, logged once per component
+	bool bDroppedSamplesLogged = false;
+	bool bDuplicateTargetsLogged = false;
+
+	// Scheduler state
+	bool bPendingUpdate = false;
+	int32 FramesWaiting = 0;
+	double LastUpdateTime = 0;
 };
 
 // ===================================================================================
@@ -90,6 +315,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "OSCActor")
 	const TArray<float>& GetOSCMultiSampleParam(const FString& Key);
 
+	UFUNCTION(BlueprintCallable, Category = "OSCActor")
+	int32 GetOSCParamHistory(const FString& Key, TArray<float>& OutValues, TArray<double>& OutTimestamps) const;
+
 	UFUNCTION(BlueprintCallable, Category = "OSCActor")
 	void UpdateInstancedStaticMesh(UInstancedStaticMeshComponent* InstancedStaticMesh, TArray<FString> InCustomDataChannels);
+
+	UFUNCTION(BlueprintCallable, Category = "OSCActor")
+	void UpdateInstancedStaticMeshes(const TArray<FOSCInstancedMeshTarget>& Targets, const FString& MeshIndexChannel);
 };
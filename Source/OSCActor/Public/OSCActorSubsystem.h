@@ -4,12 +4,16 @@
 
 #include "CoreMinimal.h"
 #include "OSCActor.h"
+#include "Containers/Ticker.h"
 #include "Subsystems/EngineSubsystem.h"
 #include "OSCServer.h"
 #include "OSCBundle.h"
 #include "OSCCineCameraActor.h"
+#include "OSCEntityTable.h"
 #include "OSCActorSubsystem.generated.h"
 
+DECLARE_STATS_GROUP(TEXT("OSCActor"), STATGROUP_OSCActor, STATCAT_Advanced);
+
 UCLASS(config=Project, defaultconfig)
 class UOSCActorSettings : public UObject
 {
@@ -25,6 +29,69 @@ public:
 
 	UPROPERTY(EditAnywhere, config, Category = OSCActor)
 	float SensorAspectRatio = 16.0 / 9.0;
+
+	// Milliseconds per engine frame spent on object updates (bindings and UpdateFromOSC).
+	// Objects over budget are deferred to a later frame, 0 updates everything immediately.
+	UPROPERTY(EditAnywhere, config, Category = "OSCActor|Scheduler", meta = (ClampMin = "0"))
+	float UpdateBudgetMs = 0;
+
+	// Priority multiplier for objects whose owner was not rendered recently
+	UPROPERTY(EditAnywhere, config, Category = "OSCActor|Scheduler", meta = (ClampMin = "0", ClampMax = "1"))
+	float NotRenderedPriorityScale = 0.1;
+
+	// Also receive packets from a same-machine sender through a named shared-memory ring buffer
+	UPROPERTY(EditAnywhere, config, Category = "OSCActor|Shared Memory")
+	bool bUseSharedMemory = false;
+
+	UPROPERTY(EditAnywhere, config, Category = "OSCActor|Shared Memory", meta = (EditCondition = "bUseSharedMemory"))
+	FString SharedMemoryName = "OSCActor";
+
+	// Reply with /sys/frame_ack <frame_number> once a frame is complete, used by load generators.
+	// Senders mark the end of a frame with /sys/frame_end <frame_number> [<message count>], the
+	// count includes both markers; frames with missing messages are not acknowledged.
+	UPROPERTY(EditAnywhere, config, Category = "OSCActor|Frame Ack")
+	bool bSendFrameAck = false;
+
+	UPROPERTY(EditAnywhere, config, Category = "OSCActor|Frame Ack", meta = (EditCondition = "bSendFrameAck"))
+	FString FrameAckAddress = "127.0.0.1";
+
+	UPROPERTY(EditAnywhere, config, Category = "OSCActor|Frame Ack", meta = (EditCondition = "bSendFrameAck"))
+	int FrameAckPort = 7001;
+
+	// Seconds an entity may go without any message before its record and instance are
+	// removed. Inactive entities that are still being sent are kept, hidden. Promoted
+	// entities are kept. 0 keeps entities until they are removed explicitly.
+	UPROPERTY(EditAnywhere, config, Category = "OSCActor|Entities", meta = (ClampMin = "0"))
+	float EntityTimeout = 5;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+};
+
+USTRUCT(BlueprintType)
+struct FOSCActorSchedulerStats
+{
+	GENERATED_BODY()
+
+	// Objects whose update ran this frame
+	UPROPERTY(Category = "OSCActor", VisibleAnywhere, BlueprintReadOnly)
+	int32 Updated = 0;
+
+	// Objects with pending data left for a later frame because the budget ran out
+	UPROPERTY(Category = "OSCActor", VisibleAnywhere, BlueprintReadOnly)
+	int32 Deferred = 0;
+
+	// Pending updates replaced by newer data before they ran
+	UPROPERTY(Category = "OSCActor", VisibleAnywhere, BlueprintReadOnly)
+	int32 Skipped = 0;
+
+	// Updates run over budget to honor UOSCActorComponent::MinUpdateRate
+	UPROPERTY(Category = "OSCActor", VisibleAnywhere, BlueprintReadOnly)
+	int32 Forced = 0;
+
+	UPROPERTY(Category = "OSCActor", VisibleAnywhere, BlueprintReadOnly)
+	float UpdateTimeMs = 0;
 };
 
 UCLASS()
@@ -42,17 +109,91 @@ public:
 	UPROPERTY(Category = "OSCActor", EditAnywhere, BlueprintReadOnly)
 	int32 FrameNumber = 0;
 
+	// Scheduler counters of the previous engine frame
+	UPROPERTY(Category = "OSCActor", VisibleAnywhere, BlueprintReadOnly)
+	FOSCActorSchedulerStats SchedulerStats;
+
 	void UpdateActorReference(UActorComponent* Component_);
 	void RemoveActorReference(UActorComponent* Component_);
 
+	// Rebinds the listener to the current settings, keeping registered components
+	void ApplySettings();
+
+	bool IsListening() const { return bListening; }
+
+	// Spawns ActorClass for an entity so it gets gameplay logic. The actor's UOSCActorComponent
+	// takes over the entity's name and messages; the instance is hidden until the actor is removed.
+	UFUNCTION(BlueprintCallable, Category = "OSCActor", meta = (WorldContext = "WorldContextObject", DeterminesOutputType = "ActorClass"))
+	AActor* PromoteEntity(UObject* WorldContextObject, const FString& Name, TSubclassOf<AActor> ActorClass);
+
+	UFUNCTION(BlueprintCallable, Category = "OSCActor")
+	bool GetEntityTransform(const FString& Name, FTransform& OutTransform) const;
+
+	UFUNCTION(BlueprintCallable, Category = "OSCActor")
+	float GetEntityParam(const FString& Name, const FString& Key, float DefaultValue = 0) const;
+
+	UFUNCTION(BlueprintCallable, Category = "OSCActor")
+	int32 GetEntityNum() const { return EntityTable.Num(); }
+
+	// Drops the entity's record and instance; it is created again by its next message
+	UFUNCTION(BlueprintCallable, Category = "OSCActor")
+	bool RemoveEntity(const FString& Name);
+
 protected:
 
 	TMap<FString, UOSCActorComponent*> OSCActorComponentMap;
 	TMap<FString, UOSCCineCameraComponent*> OSCCameraComponentMap;
 
+	TArray<class UOSCEntityRendererComponent*> EntityRenderers;
+	FOSCEntityTable EntityTable;
+
 	UPROPERTY()
 	class UOSCServer* OSCServer;
 
+	UPROPERTY()
+	class UOSCClient* FrameAckClient;
+
 	UFUNCTION()
 	void OnOscBundleReceived(const FOSCBundle& Bundle, const FString& IPAddress, int32 Port);
+
+	// TimeTag is the OSC time tag of the enclosing bundle, 0 if unknown
+	void ProcessMessages(const TArray<FOSCMessage>& Messages, uint64 TimeTag = 0);
+
+	bool Tick(float DeltaTime);
+
+	void StartListening();
+	void StopListening();
+
+	void RemoveActorReferences(UOSCActorComponent* Actor);
+
+	// Drops entries of components that were destroyed without unregistering
+	void PruneReferences();
+
+	void ProcessEntityMessage(const FString& Name, const TArray<FString>& Comp, const FOSCMessage& Message);
+	void SetEntityPromoted(const FString& Name, bool bPromoted);
+	void RemoveEntityAt(int32 Entity);
+
+	// Removes the renderer's entities and shifts the renderer index of the others
+	void RemoveEntityRenderer(int32 RendererIndex);
+	void EvictEntities();
+	void SyncEntityRenderers();
+
+	void RequestUpdate(UOSCActorComponent* Component);
+	void RunScheduledUpdates();
+	void RunUpdate(UOSCActorComponent* Component, double Now);
+
+	TArray<UOSCActorComponent*> PendingUpdates;
+
+	uint64 SchedulerFrame = 0;
+	double SchedulerSpentMs = 0;
+	FOSCActorSchedulerStats CurrentSchedulerStats;
+
+	bool bListening = false;
+
+	FTSTicker::FDelegateHandle TickHandle;
+
+	// Messages received since the last /sys/frame_number, including the marker
+	int32 FrameMessageCount = 0;
+
+	TSharedPtr<class FOSCActorSharedMemoryReceiver> SharedMemoryReceiver;
 };
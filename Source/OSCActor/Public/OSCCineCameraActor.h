@@ -28,6 +28,8 @@ public:
 
 public:
 
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
 	virtual void BeginDestroy() override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
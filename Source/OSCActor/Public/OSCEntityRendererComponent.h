@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "OSCEntityRendererComponent.generated.h"
+
+struct FOSCEntityTable;
+
+// Draws OSC objects that have no actor as instances of one mesh. Every /obj/<name>
+// starting with NamePrefix and not claimed by an UOSCActorComponent becomes a record
+// in the subsystem's entity table and one instance here.
+UCLASS(Blueprintable, ClassGroup = Rendering, meta=(BlueprintSpawnableComponent))
+class OSCACTOR_API UOSCEntityRendererComponent : public UInstancedStaticMeshComponent
+{
+	friend class UOSCActorSubsystem;
+
+	GENERATED_BODY()
+
+public:
+
+	UOSCEntityRendererComponent(const FObjectInitializer& ObjectInitializer);
+
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	virtual void BeginDestroy() override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+public:
+
+	UPROPERTY(Category = "OSCActor", EditAnywhere, BlueprintReadWrite)
+	FString NamePrefix;
+
+	// ss keys written to the per-instance custom data, in order
+	UPROPERTY(Category = "OSCActor", EditAnywhere, BlueprintReadWrite)
+	TArray<FString> CustomDataParams;
+
+	UFUNCTION(BlueprintCallable, Category = "OSCActor")
+	int32 GetEntityNum() const { return Members.Num(); }
+
+private:
+
+	void MarkSlotDirty(int32 Slot);
+	void ResetMembers();
+
+	// Moves the last instance into Slot's place and fixes up its entity's slot
+	void RemoveSlot(int32 Slot, FOSCEntityTable& Table);
+	void SyncInstances(FOSCEntityTable& Table);
+
+	// Entity index per instance
+	TArray<int32> Members;
+
+	int32 DirtyBegin = 0;
+	int32 DirtyEnd = 0;
+};
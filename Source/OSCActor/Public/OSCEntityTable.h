@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// OSC objects without an actor, stored as indexed records in columns (structure of
+// arrays). Records are created hidden on the first message for a name claimed by an
+// UOSCEntityRendererComponent, which draws them as instances once "active" is received,
+// and removed with swap-remove, so entity indices are only stable until the next removal.
+struct OSCACTOR_API FOSCEntityTable
+{
+	int32 Num() const { return Names.Num(); }
+
+	int32 Find(const FString& Name) const
+	{
+		const int32* Index = NameToIndex.Find(Name);
+		return Index ? *Index : INDEX_NONE;
+	}
+
+	int32 Add(const FString& Name, int32 Renderer, int32 Slot);
+	void Reset();
+
+	// Moves the last record into Entity's place, returns its previous index or INDEX_NONE
+	int32 RemoveAtSwap(int32 Entity);
+
+	// Column of the ss key, INDEX_NONE if no entity received it yet and !bCreate
+	int32 GetParamColumn(const FString& Key, bool bCreate);
+
+	void SetParam(int32 Entity, int32 Column, float Value) { ParamColumns[Column][Entity] = Value; }
+	float GetParam(int32 Entity, const FString& Key, float DefaultValue) const;
+	void GetParams(int32 Entity, TMap<FString, float>& OutParams) const;
+
+	// Columns, indexed by entity
+	TArray<FString> Names;
+	TArray<FTransform> Transforms;
+	TBitArray<> Visible;
+	TBitArray<> Promoted;
+	TArray<int32> Renderers;
+	TArray<int32> Slots;
+
+	// FPlatformTime::Seconds() of the last message received
+	TArray<double> LastSeenTimes;
+
+	// ParamColumns[Column][Entity]
+	TArray<TArray<float>> ParamColumns;
+
+private:
+
+	TMap<FString, int32> NameToIndex;
+	TMap<FString, int32> ParamKeys;
+};
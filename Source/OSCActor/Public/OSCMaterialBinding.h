@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "OSCMaterialBinding.generated.h"
+
+class UMaterialInstanceDynamic;
+class UMaterialParameterCollection;
+class UMaterialParameterCollectionInstance;
+
+UENUM(BlueprintType)
+enum class EOSCMaterialBindingTarget : uint8
+{
+	DynamicMaterials,
+	ParameterCollection,
+};
+
+UENUM(BlueprintType)
+enum class EOSCMaterialParameterChannel : uint8
+{
+	Scalar,
+	R,
+	G,
+	B,
+	A,
+};
+
+// Drives one material parameter (or one channel of a vector parameter) from an ss key
+USTRUCT(BlueprintType)
+struct FOSCMaterialParameterBinding
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OSCActor")
+	FString Key;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OSCActor")
+	EOSCMaterialBindingTarget Target = EOSCMaterialBindingTarget::DynamicMaterials;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OSCActor", meta = (EditCondition = "Target == EOSCMaterialBindingTarget::ParameterCollection"))
+	UMaterialParameterCollection* Collection = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OSCActor")
+	FName ParameterName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OSCActor")
+	EOSCMaterialParameterChannel Channel = EOSCMaterialParameterChannel::Scalar;
+};
+
+UCLASS(BlueprintType)
+class OSCACTOR_API UOSCMaterialBindingAsset : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "OSCActor")
+	TArray<FOSCMaterialParameterBinding> Bindings;
+
+	// Call after changing Bindings from code so components resolve them again.
+	// Editor changes do this automatically.
+	UFUNCTION(BlueprintCallable, Category = "OSCActor")
+	void MarkBindingsChanged() { Version++; }
+
+	// Bumped whenever Bindings changes
+	uint32 GetVersion() const { return Version; }
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+
+	uint32 Version = 0;
+};
+
+// ===================================================================================
+
+// Per-component runtime state of a binding asset. Parameter indices are resolved
+// once and only values that changed since the last frame are written.
+struct OSCACTOR_API FOSCMaterialBindingState
+{
+	void Reset() { ResolvedAsset = nullptr; ResolvedVersion = 0; Parameters.Reset(); }
+
+	void Apply(UWorld* World, const UOSCMaterialBindingAsset* Asset, const TArray<UMaterialInstanceDynamic*>& Materials, const TMap<FString, float>& Params);
+
+private:
+
+	struct FResolvedParameter
+	{
+		EOSCMaterialBindingTarget Target;
+		TWeakObjectPtr<UMaterialParameterCollectionInstance> CollectionInstance;
+		FName ParameterName;
+		bool bVector = false;
+
+		// Scalar parameters only use Keys[0]; vector parameters one key per channel
+		FString Keys[4];
+
+		FLinearColor Value = FLinearColor::Black;
+		bool bHasValue = false;
+
+		// Parameter index per bound dynamic material
+		TArray<int32> MaterialIndices;
+	};
+
+	void Resolve(UWorld* World, const UOSCMaterialBindingAsset* Asset, const TArray<UMaterialInstanceDynamic*>& Materials);
+
+	const UOSCMaterialBindingAsset* ResolvedAsset = nullptr;
+	uint32 ResolvedVersion = 0;
+	TWeakObjectPtr<UWorld> ResolvedWorld;
+	TArray<TWeakObjectPtr<UMaterialInstanceDynamic>> ResolvedMaterials;
+	TArray<FResolvedParameter> Parameters;
+};
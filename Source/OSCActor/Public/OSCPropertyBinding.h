@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OSCPropertyBinding.generated.h"
+
+struct FChannelData;
+
+// Copies an ss value or ms channel into a property of the owner actor or one of its components
+USTRUCT(BlueprintType)
+struct FOSCPropertyBinding
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OSCActor")
+	FString Key;
+
+	// Read the ms channel Key instead of the ss value. Samples fill the numeric fields
+	// of a struct property (FVector, FLinearColor, ...) in order, or a float array.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OSCActor")
+	bool bMultiSample = false;
+
+	// Component of the owner actor holding the property, None for the actor itself
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OSCActor")
+	FName ComponentName;
+
+	// Property name, with '.' to reach into struct members, e.g. "Intensity" or "RelativeScale3D.Z"
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OSCActor")
+	FString PropertyPath;
+};
+
+// ===================================================================================
+
+// Per-component runtime state of a binding table. Property paths are resolved once to
+// the target object, the top-level FProperty and the offsets of the leaf fields, and
+// again whenever the owner bumps BindingsVersion.
+struct OSCACTOR_API FOSCPropertyBindingState
+{
+	void Reset() { bResolved = false; Targets.Reset(); }
+
+	void Apply(AActor* Owner, const TArray<FOSCPropertyBinding>& Bindings, uint32 BindingsVersion,
+		const TMap<FString, float>& Params, const TMap<FString, FChannelData>& MultiSampleParams);
+
+private:
+
+	struct FField
+	{
+		const FNumericProperty* Numeric;
+		const FBoolProperty* Bool;
+		int32 Offset; // relative to the top-level property value
+	};
+
+	struct FResolvedBinding
+	{
+		int32 BindingIndex;
+		const FProperty* TopProperty;
+		int32 TopOffset;
+
+		// Relative location, rotation or scale of a scene component
+		bool bTransform = false;
+
+		// Numeric / bool leaves, or a single float / double array
+		TArray<FField> Fields;
+		const FArrayProperty* ArrayProperty = nullptr;
+		int32 ArrayOffset = 0;
+	};
+
+	struct FTarget
+	{
+		TWeakObjectPtr<UObject> Object;
+		TArray<FResolvedBinding> Bindings;
+	};
+
+	static bool AddField(const FProperty* Property, int32 Offset, TArray<FField>& OutFields);
+
+	void Resolve(AActor* Owner, const TArray<FOSCPropertyBinding>& Bindings, uint32 BindingsVersion);
+	bool Write(const FResolvedBinding& Binding, uint8* Value, const float* Scalar, const TArray<float>* Samples) const;
+
+	bool bResolved = false;
+	TWeakObjectPtr<AActor> ResolvedOwner;
+	uint32 ResolvedBindingsVersion = 0;
+	int32 ResolvedBindingsNum = 0;
+	TArray<FTarget> Targets;
+	TArray<uint8> Scratch;
+};